@@ -0,0 +1,187 @@
+// Microbenchmark: Parsing the fields of a fence request
+//
+// Compares the copy-based parsing, which copies each field into a CharBuffer and splits it into
+// a second CharBuffer, with the field views, which reference the received frame and copy only
+// the node name and the secret.
+//
+// Build from the bench directory against the dsaext sources that the server is built with,
+// see the Makefile:
+//   make DSAEXT_DIR=<dsaext source directory> field_parse_bench
+//
+// Usage: field_parse_bench [iterations]
+
+#include <cstddef>
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <new>
+#include <CharBuffer.h>
+
+#include "Shared.h"
+#include "exceptions.h"
+
+namespace
+{
+    const size_t IO_BUFFER_SIZE         = 1024;
+    const size_t FIELD_SIZE             = 1024;
+    const size_t NODENAME_SIZE          = 255;
+    const size_t DFLT_ITERATIONS        = 2000000;
+
+    // Fields of a typical fence request
+    const char* const REQUEST_FIELDS[] =
+    {
+        "NODENAME=cluster-node-017.example.net",
+        "SECRET=0123456789abcdef0123456789abcdef"
+    };
+    const size_t REQUEST_FIELD_COUNT = sizeof (REQUEST_FIELDS) / sizeof (REQUEST_FIELDS[0]);
+
+    // @throws ProtocolException
+    size_t build_request(char* const io_buffer)
+    {
+        size_t offset = 0;
+        for (size_t idx = 0; idx < REQUEST_FIELD_COUNT; ++idx)
+        {
+            const std::string field_contents(REQUEST_FIELDS[idx]);
+            protocol::write_field(io_buffer, IO_BUFFER_SIZE, offset, field_contents);
+        }
+        return offset;
+    }
+
+    // Parsing as implemented before the field views were introduced
+    // @throws ProtocolException
+    void parse_copy(
+        const char* const   io_buffer,
+        const size_t        io_length,
+        CharBuffer&         key_buffer,
+        CharBuffer&         value_buffer,
+        CharBuffer&         nodename,
+        CharBuffer&         secret
+    )
+    {
+        size_t field_offset = 0;
+        while (field_offset < io_length)
+        {
+            protocol::read_field(io_buffer, io_length, field_offset, key_buffer);
+            protocol::split_key_value_pair(key_buffer, value_buffer);
+            if (key_buffer == protocol::NODENAME)
+            {
+                nodename = value_buffer;
+            }
+            else
+            if (key_buffer == protocol::SECRET)
+            {
+                secret = value_buffer;
+            }
+        }
+    }
+
+    // Parsing as implemented by the server's decode_fence_fields()
+    protocol::DecodeStatus parse_view(
+        const char* const   io_buffer,
+        const size_t        io_length,
+        CharBuffer&         nodename,
+        CharBuffer&         secret
+    ) noexcept
+    {
+        protocol::DecodeStatus status = protocol::DecodeStatus::OK;
+        protocol::FieldView field;
+        protocol::FieldView key;
+        protocol::FieldView value;
+        size_t field_offset = 0;
+        while (status == protocol::DecodeStatus::OK && field_offset < io_length)
+        {
+            status = protocol::decode_field(io_buffer, io_length, field_offset, field);
+            if (status == protocol::DecodeStatus::OK)
+            {
+                status = protocol::decode_key_value_pair(field, key, value);
+            }
+            if (status == protocol::DecodeStatus::OK)
+            {
+                if (key.equals(protocol::NODENAME))
+                {
+                    status = value.decode_to(nodename, NODENAME_SIZE);
+                }
+                else
+                if (key.equals(protocol::SECRET))
+                {
+                    status = value.decode_to(secret, protocol::MAX_SECRET_LENGTH);
+                }
+            }
+        }
+        return status;
+    }
+
+    void report(const char* const label, const std::chrono::steady_clock::duration elapsed, const size_t iterations)
+    {
+        const double nsecs = static_cast<double> (
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()
+        );
+        std::cout << label << ": " << (nsecs / iterations) << " ns/request" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int exit_code = EXIT_FAILURE;
+    try
+    {
+        size_t iterations = DFLT_ITERATIONS;
+        if (argc >= 2)
+        {
+            iterations = std::stoul(argv[1]);
+        }
+
+        char io_buffer[IO_BUFFER_SIZE];
+        const size_t io_length = build_request(io_buffer);
+
+        CharBuffer key_buffer(FIELD_SIZE);
+        CharBuffer value_buffer(FIELD_SIZE);
+        CharBuffer nodename(NODENAME_SIZE);
+        CharBuffer secret(protocol::MAX_SECRET_LENGTH);
+
+        // Results are accumulated, so that the compiler can not discard the parsing
+        size_t result_length = 0;
+
+        const std::chrono::steady_clock::time_point copy_start = std::chrono::steady_clock::now();
+        for (size_t count = 0; count < iterations; ++count)
+        {
+            parse_copy(io_buffer, io_length, key_buffer, value_buffer, nodename, secret);
+            result_length += nodename.length() + secret.length();
+        }
+        const std::chrono::steady_clock::duration copy_time = std::chrono::steady_clock::now() - copy_start;
+
+        const std::chrono::steady_clock::time_point view_start = std::chrono::steady_clock::now();
+        for (size_t count = 0; count < iterations; ++count)
+        {
+            if (parse_view(io_buffer, io_length, nodename, secret) != protocol::DecodeStatus::OK)
+            {
+                throw ProtocolException();
+            }
+            result_length += nodename.length() + secret.length();
+        }
+        const std::chrono::steady_clock::duration view_time = std::chrono::steady_clock::now() - view_start;
+
+        std::cout << "Iterations: " << iterations << " (result length " << result_length << ")" << std::endl;
+        report("Copy-based parsing", copy_time, iterations);
+        report("Field view parsing", view_time, iterations);
+        exit_code = EXIT_SUCCESS;
+    }
+    catch (ProtocolException&)
+    {
+        std::cerr << "Protocol error while parsing the request" << std::endl;
+    }
+    catch (std::invalid_argument&)
+    {
+        std::cerr << "Invalid number of iterations" << std::endl;
+    }
+    catch (std::out_of_range&)
+    {
+        std::cerr << "Invalid number of iterations" << std::endl;
+    }
+    catch (std::bad_alloc&)
+    {
+        std::cerr << "Out of memory" << std::endl;
+    }
+    return exit_code;
+}
@@ -0,0 +1,279 @@
+// Benchmark: Handing requests to worker threads through a queue
+//
+// Compares the lock-free MpmcQueue with the intrusive Queue protected by a mutex, which the server used
+// for its action queue before. Both queues are bounded to the same capacity, and consumers that find
+// the queue empty yield instead of waiting on a condition variable, so that only the queues themselves
+// are compared.
+//
+// Throughput: All producers enqueue their items as fast as possible, while all consumers dequeue them.
+// Latency: Each producer enqueues a single item and waits until a consumer has dequeued it before
+// enqueueing the next item; the time from enqueueing to dequeueing is recorded for each item.
+//
+// Build from the bench directory, the benchmark depends on header-only sources only:
+//   make queue_bench
+//
+// Usage: queue_bench [producers] [consumers] [items per producer]
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+#include <functional>
+#include <new>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "Queue.h"
+#include "MpmcQueue.h"
+
+namespace
+{
+    const size_t QUEUE_CAPACITY             = 1024;
+    const size_t DFLT_PRODUCERS             = 4;
+    const size_t DFLT_CONSUMERS             = 4;
+    const size_t DFLT_ITEMS_PER_PRODUCER    = 500000;
+    // The latency test hands over each item separately, therefore fewer items are used
+    const size_t LATENCY_ITEMS_DIVISOR      = 10;
+
+    class Item : public Queue<Item>::Node
+    {
+      public:
+        std::chrono::steady_clock::time_point   enqueue_time;
+        std::atomic<bool>                       consumed;
+
+        Item()
+        {
+            consumed.store(false, std::memory_order_relaxed);
+        }
+
+        virtual ~Item() noexcept
+        {
+        }
+
+        Item(const Item& other) = delete;
+        Item(Item&& orig) = delete;
+        virtual Item& operator=(const Item& other) = delete;
+        virtual Item& operator=(Item&& orig) = delete;
+    };
+
+    // The intrusive Queue protected by a mutex, with the same interface as the MpmcQueue
+    class LockedQueue
+    {
+      private:
+        std::mutex  queue_lock;
+        Queue<Item> item_queue;
+        size_t      capacity    = 0;
+
+      public:
+        LockedQueue(const size_t min_capacity)
+        {
+            capacity = min_capacity;
+        }
+
+        virtual ~LockedQueue() noexcept
+        {
+        }
+
+        LockedQueue(const LockedQueue& other) = delete;
+        LockedQueue(LockedQueue&& orig) = delete;
+        virtual LockedQueue& operator=(const LockedQueue& other) = delete;
+        virtual LockedQueue& operator=(LockedQueue&& orig) = delete;
+
+        virtual bool enqueue(Item* const item) noexcept
+        {
+            std::unique_lock<std::mutex> lock(queue_lock);
+            const bool enqueued = item_queue.get_size() < capacity;
+            if (enqueued)
+            {
+                item_queue.add_last(item);
+            }
+            return enqueued;
+        }
+
+        virtual Item* dequeue() noexcept
+        {
+            std::unique_lock<std::mutex> lock(queue_lock);
+            return item_queue.remove_first();
+        }
+    };
+
+    struct Result
+    {
+        double  ops_per_sec     = 0;
+        double  p50_usecs       = 0;
+        double  p99_usecs       = 0;
+    };
+
+    template<typename Q>
+    void consume(
+        Q&                                  queue,
+        std::atomic<size_t>&                remain_count,
+        std::vector<std::chrono::nanoseconds>* const latency_list
+    )
+    {
+        while (remain_count.load(std::memory_order_relaxed) > 0)
+        {
+            Item* const item = queue.dequeue();
+            if (item != nullptr)
+            {
+                if (latency_list != nullptr)
+                {
+                    latency_list->push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - item->enqueue_time
+                    ));
+                }
+                item->consumed.store(true, std::memory_order_release);
+                remain_count.fetch_sub(1, std::memory_order_relaxed);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    template<typename Q>
+    void produce(Q& queue, Item* const item_list, const size_t item_count, const bool await_flag)
+    {
+        for (size_t idx = 0; idx < item_count; ++idx)
+        {
+            Item* const item = &(item_list[idx]);
+            item->enqueue_time = std::chrono::steady_clock::now();
+            while (!queue.enqueue(item))
+            {
+                std::this_thread::yield();
+            }
+            if (await_flag)
+            {
+                while (!item->consumed.load(std::memory_order_acquire))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }
+    }
+
+    // @throws std::bad_alloc, std::system_error
+    template<typename Q>
+    Result run(const size_t producers, const size_t consumers, const size_t items_per_producer, const bool latency_flag)
+    {
+        Q queue(QUEUE_CAPACITY);
+        const size_t item_count = producers * items_per_producer;
+        std::unique_ptr<Item[]> item_list_mgr(new Item[item_count]);
+        Item* const item_list = item_list_mgr.get();
+
+        std::atomic<size_t> remain_count(item_count);
+        std::unique_ptr<std::vector<std::chrono::nanoseconds>[]> latency_lists(
+            new std::vector<std::chrono::nanoseconds>[consumers]
+        );
+
+        const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        std::vector<std::thread> thread_list;
+        for (size_t idx = 0; idx < consumers; ++idx)
+        {
+            std::vector<std::chrono::nanoseconds>* latency_list = nullptr;
+            if (latency_flag)
+            {
+                // Reserved in advance, so that consumers never allocate
+                latency_list = &(latency_lists[idx]);
+                latency_list->reserve(item_count);
+            }
+            thread_list.push_back(std::thread(consume<Q>, std::ref(queue), std::ref(remain_count), latency_list));
+        }
+        for (size_t idx = 0; idx < producers; ++idx)
+        {
+            thread_list.push_back(std::thread(
+                produce<Q>, std::ref(queue), &(item_list[idx * items_per_producer]), items_per_producer,
+                latency_flag
+            ));
+        }
+        for (std::thread& thread : thread_list)
+        {
+            thread.join();
+        }
+        const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start_time;
+
+        Result result;
+        result.ops_per_sec = static_cast<double> (item_count) /
+            std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+        if (latency_flag)
+        {
+            std::vector<std::chrono::nanoseconds> latency_list;
+            for (size_t idx = 0; idx < consumers; ++idx)
+            {
+                latency_list.insert(latency_list.end(), latency_lists[idx].begin(), latency_lists[idx].end());
+            }
+            std::sort(latency_list.begin(), latency_list.end());
+            if (!latency_list.empty())
+            {
+                result.p50_usecs = latency_list[latency_list.size() / 2].count() / 1000.0;
+                result.p99_usecs = latency_list[latency_list.size() * 99 / 100].count() / 1000.0;
+            }
+        }
+        return result;
+    }
+
+    size_t parse_count(const char* const arg)
+    {
+        const size_t count = std::stoul(arg);
+        if (count == 0)
+        {
+            throw std::invalid_argument("Count must be greater than 0");
+        }
+        return count;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int exit_code = EXIT_FAILURE;
+    try
+    {
+        const size_t producers = argc >= 2 ? parse_count(argv[1]) : DFLT_PRODUCERS;
+        const size_t consumers = argc >= 3 ? parse_count(argv[2]) : DFLT_CONSUMERS;
+        const size_t items_per_producer = argc >= 4 ? parse_count(argv[3]) : DFLT_ITEMS_PER_PRODUCER;
+        const size_t latency_items = std::max(items_per_producer / LATENCY_ITEMS_DIVISOR, static_cast<size_t> (1));
+
+        std::cout << "Producers: " << producers << ", consumers: " << consumers << ", CPUs: " <<
+            std::thread::hardware_concurrency() << std::endl;
+
+        const Result locked_tput = run<LockedQueue>(producers, consumers, items_per_producer, false);
+        const Result mpmc_tput = run<MpmcQueue<Item>>(producers, consumers, items_per_producer, false);
+        std::cout << "Throughput, Queue + mutex: " << (locked_tput.ops_per_sec / 1000000) << " M items/s" <<
+            std::endl;
+        std::cout << "Throughput, MpmcQueue:     " << (mpmc_tput.ops_per_sec / 1000000) << " M items/s" <<
+            std::endl;
+
+        const Result locked_lat = run<LockedQueue>(producers, consumers, latency_items, true);
+        const Result mpmc_lat = run<MpmcQueue<Item>>(producers, consumers, latency_items, true);
+        std::cout << "Latency, Queue + mutex:    p50 " << locked_lat.p50_usecs << " us, p99 " <<
+            locked_lat.p99_usecs << " us" << std::endl;
+        std::cout << "Latency, MpmcQueue:        p50 " << mpmc_lat.p50_usecs << " us, p99 " <<
+            mpmc_lat.p99_usecs << " us" << std::endl;
+        exit_code = EXIT_SUCCESS;
+    }
+    catch (std::invalid_argument&)
+    {
+        std::cerr << "Invalid count argument" << std::endl;
+    }
+    catch (std::out_of_range&)
+    {
+        std::cerr << "Invalid count argument" << std::endl;
+    }
+    catch (std::bad_alloc&)
+    {
+        std::cerr << "Out of memory" << std::endl;
+    }
+    catch (std::system_error&)
+    {
+        std::cerr << "Thread creation failed" << std::endl;
+    }
+    return exit_code;
+}
@@ -0,0 +1,311 @@
+// Benchmark: Executing tasks on a pool of worker threads
+//
+// Compares the work-stealing WorkerPool with a pool of worker threads that wait on a single condition
+// variable and take tasks from a single mutex-protected queue, as the server's worker pool did before.
+//
+// A single submitter thread, like the selector thread of a reactor shard, submits bursts of short
+// tasks and waits until each burst has been executed. Throughput is the number of tasks executed
+// per second, latency is the time from submitting a task until a worker thread starts executing it.
+//
+// Build from the bench directory against the dsaext sources that the server is built with,
+// see the Makefile:
+//   make DSAEXT_DIR=<dsaext source directory> worker_pool_bench
+//
+// Usage: worker_pool_bench [workers] [tasks per burst] [bursts] [work iterations per task]
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <system_error>
+#include <new>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "Queue.h"
+#include "WorkerPool.h"
+
+namespace
+{
+    const size_t DFLT_WORKERS           = 4;
+    const size_t DFLT_BURST_SIZE        = 64;
+    const size_t DFLT_BURST_COUNT       = 20000;
+    const size_t DFLT_WORK_ITERATIONS   = 200;
+
+    class BenchTask : public WorkerPool::Task, public Queue<BenchTask>::Node
+    {
+      public:
+        std::chrono::steady_clock::time_point   submit_time;
+        std::chrono::nanoseconds                latency;
+
+        BenchTask()
+        {
+        }
+
+        virtual ~BenchTask() noexcept
+        {
+        }
+
+        BenchTask(const BenchTask& other) = delete;
+        BenchTask(BenchTask&& orig) = delete;
+        virtual BenchTask& operator=(const BenchTask& other) = delete;
+        virtual BenchTask& operator=(BenchTask&& orig) = delete;
+    };
+
+    class BenchExecutor : public WorkerPool::WorkerPoolExecutor
+    {
+      public:
+        std::atomic<size_t> completed_count;
+        size_t              work_iterations     = 0;
+
+        BenchExecutor(const size_t task_work_iterations)
+        {
+            completed_count.store(0);
+            work_iterations = task_work_iterations;
+        }
+
+        virtual ~BenchExecutor() noexcept
+        {
+        }
+
+        BenchExecutor(const BenchExecutor& other) = delete;
+        BenchExecutor(BenchExecutor&& orig) = delete;
+        virtual BenchExecutor& operator=(const BenchExecutor& other) = delete;
+        virtual BenchExecutor& operator=(BenchExecutor&& orig) = delete;
+
+        virtual void run(WorkerPool::Task* const task) noexcept override
+        {
+            BenchTask* const bench_task = static_cast<BenchTask*> (task);
+            bench_task->latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - bench_task->submit_time
+            );
+
+            // Simulated request processing
+            volatile size_t work_counter = 0;
+            for (size_t count = 0; count < work_iterations; ++count)
+            {
+                work_counter = work_counter + 1;
+            }
+
+            completed_count.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    // Worker threads waiting on a single condition variable for tasks on a single mutex-protected queue
+    class CondvarPool
+    {
+      private:
+        std::mutex                  pool_lock;
+        std::condition_variable     pool_condition;
+        Queue<BenchTask>            task_queue;
+        std::vector<std::thread>    pool_threads;
+        WorkerPool::WorkerPoolExecutor* pool_executor   = nullptr;
+        bool                        stop_workers        = false;
+
+        void worker_loop() noexcept
+        {
+            std::unique_lock<std::mutex> lock(pool_lock);
+            while (!stop_workers)
+            {
+                BenchTask* const task = task_queue.remove_first();
+                if (task != nullptr)
+                {
+                    lock.unlock();
+                    pool_executor->run(task);
+                    lock.lock();
+                }
+                else
+                {
+                    pool_condition.wait(lock);
+                }
+            }
+        }
+
+      public:
+        CondvarPool(WorkerPool::WorkerPoolExecutor* const executor)
+        {
+            pool_executor = executor;
+        }
+
+        virtual ~CondvarPool() noexcept
+        {
+            stop();
+        }
+
+        CondvarPool(const CondvarPool& other) = delete;
+        CondvarPool(CondvarPool&& orig) = delete;
+        virtual CondvarPool& operator=(const CondvarPool& other) = delete;
+        virtual CondvarPool& operator=(CondvarPool&& orig) = delete;
+
+        // @throws std::system_error
+        virtual void start(const size_t worker_count)
+        {
+            for (size_t idx = 0; idx < worker_count; ++idx)
+            {
+                pool_threads.push_back(std::thread(&CondvarPool::worker_loop, this));
+            }
+        }
+
+        virtual void stop() noexcept
+        {
+            {
+                std::unique_lock<std::mutex> lock(pool_lock);
+                stop_workers = true;
+                pool_condition.notify_all();
+            }
+            for (std::thread& thread : pool_threads)
+            {
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
+            }
+        }
+
+        virtual void submit(BenchTask* const task) noexcept
+        {
+            std::unique_lock<std::mutex> lock(pool_lock);
+            task_queue.add_last(task);
+            pool_condition.notify_one();
+        }
+    };
+
+    struct Result
+    {
+        double  tasks_per_sec   = 0;
+        double  p50_usecs       = 0;
+        double  p99_usecs       = 0;
+    };
+
+    // Submits the bursts of tasks through the submit function and waits for the completion of each burst
+    template<typename F>
+    Result run_bursts(BenchExecutor& executor, const size_t burst_size, const size_t burst_count, F submit)
+    {
+        std::unique_ptr<BenchTask[]> task_list_mgr(new BenchTask[burst_size]);
+        BenchTask* const task_list = task_list_mgr.get();
+        std::vector<std::chrono::nanoseconds> latency_list;
+        latency_list.reserve(burst_size * burst_count);
+
+        const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        for (size_t burst = 0; burst < burst_count; ++burst)
+        {
+            for (size_t idx = 0; idx < burst_size; ++idx)
+            {
+                task_list[idx].submit_time = std::chrono::steady_clock::now();
+                submit(&(task_list[idx]));
+            }
+            const size_t target_count = (burst + 1) * burst_size;
+            while (executor.completed_count.load(std::memory_order_acquire) < target_count)
+            {
+                std::this_thread::yield();
+            }
+            for (size_t idx = 0; idx < burst_size; ++idx)
+            {
+                latency_list.push_back(task_list[idx].latency);
+            }
+        }
+        const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - start_time;
+
+        Result result;
+        result.tasks_per_sec = static_cast<double> (burst_size * burst_count) /
+            std::chrono::duration_cast<std::chrono::duration<double>>(elapsed).count();
+        std::sort(latency_list.begin(), latency_list.end());
+        if (!latency_list.empty())
+        {
+            result.p50_usecs = latency_list[latency_list.size() / 2].count() / 1000.0;
+            result.p99_usecs = latency_list[latency_list.size() * 99 / 100].count() / 1000.0;
+        }
+        return result;
+    }
+
+    void report(const char* const label, const Result& result)
+    {
+        std::cout << label << ": " << (result.tasks_per_sec / 1000000) << " M tasks/s, latency p50 " <<
+            result.p50_usecs << " us, p99 " << result.p99_usecs << " us" << std::endl;
+    }
+
+    size_t parse_count(const char* const arg)
+    {
+        const size_t count = std::stoul(arg);
+        if (count == 0)
+        {
+            throw std::invalid_argument("Count must be greater than 0");
+        }
+        return count;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int exit_code = EXIT_FAILURE;
+    try
+    {
+        const size_t workers = argc >= 2 ? parse_count(argv[1]) : DFLT_WORKERS;
+        const size_t burst_size = argc >= 3 ? parse_count(argv[2]) : DFLT_BURST_SIZE;
+        const size_t burst_count = argc >= 4 ? parse_count(argv[3]) : DFLT_BURST_COUNT;
+        const size_t work_iterations = argc >= 5 ? std::stoul(argv[4]) : DFLT_WORK_ITERATIONS;
+
+        Result condvar_result;
+        {
+            BenchExecutor executor(work_iterations);
+            CondvarPool pool(&executor);
+            pool.start(workers);
+            condvar_result = run_bursts(
+                executor, burst_size, burst_count,
+                [&pool](BenchTask* const task)
+                {
+                    pool.submit(task);
+                }
+            );
+            pool.stop();
+        }
+
+        Result stealing_result;
+        {
+            BenchExecutor executor(work_iterations);
+            WorkerPool pool(workers, workers, std::chrono::milliseconds(60000), burst_size, &executor);
+            pool.start();
+            stealing_result = run_bursts(
+                executor, burst_size, burst_count,
+                [&pool](BenchTask* const task)
+                {
+                    if (!pool.submit(task, WorkerPool::Priority::NORMAL))
+                    {
+                        throw std::runtime_error("Task submission failed");
+                    }
+                }
+            );
+            pool.stop();
+        }
+
+        std::cout << "Workers: " << workers << ", tasks per burst: " << burst_size << ", bursts: " <<
+            burst_count << ", CPUs: " << std::thread::hardware_concurrency() << std::endl;
+        report("Single condition variable pool", condvar_result);
+        report("Work-stealing WorkerPool      ", stealing_result);
+        exit_code = EXIT_SUCCESS;
+    }
+    catch (std::invalid_argument&)
+    {
+        std::cerr << "Invalid count argument" << std::endl;
+    }
+    catch (std::out_of_range&)
+    {
+        std::cerr << "Invalid count argument" << std::endl;
+    }
+    catch (std::runtime_error& exc)
+    {
+        std::cerr << exc.what() << std::endl;
+    }
+    catch (std::bad_alloc&)
+    {
+        std::cerr << "Out of memory" << std::endl;
+    }
+    return exit_code;
+}
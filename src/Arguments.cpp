@@ -1,6 +1,8 @@
 #include "Arguments.h"
 
+#include <string>
 #include <RangeException.h>
+#include <integerparse.h>
 #include <iostream> // FIXME: DEBUG
 
 const char Arguments::SPLIT_CHAR = '=';
@@ -152,6 +154,45 @@ CharBuffer& Arguments::get_value(const char* const key)
     return arg_entry->get_value();
 }
 
+// @throws std::bad_alloc, ArgumentsException
+size_t Arguments::get_count_value(
+    const char* const key,
+    const size_t dflt_value,
+    const size_t min_value,
+    const size_t max_value
+)
+{
+    size_t count_value = dflt_value;
+    const CharBuffer& param_value = get_value(key);
+    if (param_value.length() > 0)
+    {
+        bool valid_flag = false;
+        try
+        {
+            count_value = dsaext::parse_unsigned_int32_c_str(param_value.c_str(), param_value.length());
+            valid_flag = count_value >= min_value && count_value <= max_value;
+        }
+        catch (dsaext::NumberFormatException&)
+        {
+            // No-op; handled the same way as an out-of-range value
+        }
+        if (!valid_flag)
+        {
+            std::string error_msg("Invalid value \"");
+            error_msg += param_value.c_str();
+            error_msg += "\" for parameter ";
+            error_msg += key;
+            error_msg += ", the value must be in the range [";
+            error_msg += std::to_string(min_value);
+            error_msg += ", ";
+            error_msg += std::to_string(max_value);
+            error_msg += "]";
+            throw ArgumentsException(error_msg);
+        }
+    }
+    return count_value;
+}
+
 int Arguments::compare_keys(const CharBuffer* const key, const CharBuffer* const other)
 {
     int rc = 0;
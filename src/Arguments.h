@@ -77,6 +77,11 @@ class Arguments
     // @throws std::bad_alloc, ArgumentsException
     virtual void check_required() const;
 
+  protected:
+    // Returns the value of an optional numeric parameter, or the default value if the parameter is not set
+    // @throws std::bad_alloc, ArgumentsException
+    size_t get_count_value(const char* key, size_t dflt_value, size_t min_value, size_t max_value);
+
   private:
     static int compare_keys(const CharBuffer* const key, const CharBuffer* const other);
 };
@@ -105,7 +105,20 @@ std::unique_ptr<ClientConnector> Client::init_connector(ClientParameters& params
     CharBuffer& ip_address = params.get_value(ClientParameters::KEY_IP_ADDRESS);
     CharBuffer& tcp_port = params.get_value(ClientParameters::KEY_TCP_PORT);
 
-    return std::unique_ptr<ClientConnector>(new ClientConnector(protocol, ip_address, tcp_port));
+    std::unique_ptr<ClientConnector> connector(new ClientConnector(protocol, ip_address, tcp_port));
+    params.get_socket_tuning(connector->get_socket_tuning());
+    return connector;
+}
+
+void Client::mark_connection_required(ClientParameters& params)
+{
+    params.mark_required(ClientParameters::KEY_PROTOCOL);
+    params.mark_required(ClientParameters::KEY_IP_ADDRESS);
+    // If the protocol is UNIX, the ip_address is the path of the server's unix domain socket
+    if (!(params.get_value(ClientParameters::KEY_PROTOCOL) == keyword::PROTO_UNIX))
+    {
+        params.mark_required(ClientParameters::KEY_TCP_PORT);
+    }
 }
 
 // @throws std::bad_alloc, OsException, InetException, ClientException, ProtocolException, ArgumentsException
@@ -113,16 +126,13 @@ bool Client::check_server_connection(ClientParameters& params)
 {
     bool rc = false;
 
-    params.mark_required(ClientParameters::KEY_PROTOCOL);
-    params.mark_required(ClientParameters::KEY_IP_ADDRESS);
-    params.mark_required(ClientParameters::KEY_TCP_PORT);
+    mark_connection_required(params);
 
     params.check_required();
 
     std::unique_ptr<ClientConnector> connector_mgr = init_connector(params);
     ClientConnector& connector = *connector_mgr;
 
-    connector.connect_to_server();
     rc = connector.check_connection();
     connector.disconnect_from_server();
 
@@ -132,11 +142,15 @@ bool Client::check_server_connection(ClientParameters& params)
 // @throws std::bad_alloc, OsException, InetException, ClientException, ProtocolException, ArgumentsException
 bool Client::fence_action(ClientParameters& params)
 {
+    // A node list selects the batch fencing action, which fences all nodes of the list with a single request
+    if (params.get_value(ClientParameters::KEY_NODELIST).length() > 0)
+    {
+        return fence_batch_action(params);
+    }
+
     bool rc = false;
 
-    params.mark_required(ClientParameters::KEY_PROTOCOL);
-    params.mark_required(ClientParameters::KEY_IP_ADDRESS);
-    params.mark_required(ClientParameters::KEY_TCP_PORT);
+    mark_connection_required(params);
     params.mark_required(ClientParameters::KEY_NODENAME);
     params.mark_required(ClientParameters::KEY_SECRET);
 
@@ -145,8 +159,6 @@ bool Client::fence_action(ClientParameters& params)
     std::unique_ptr<ClientConnector> connector_mgr = init_connector(params);
     ClientConnector& connector = *connector_mgr;
 
-    connector.connect_to_server();
-
     CharBuffer& action = params.get_value(ClientParameters::KEY_ACTION);
     CharBuffer& nodename = params.get_value(ClientParameters::KEY_NODENAME);
     CharBuffer& secret = params.get_value(ClientParameters::KEY_SECRET);
@@ -178,6 +190,97 @@ bool Client::fence_action(ClientParameters& params)
     return rc;
 }
 
+// @throws std::bad_alloc, OsException, InetException, ClientException, ProtocolException, ArgumentsException
+bool Client::fence_batch_action(ClientParameters& params)
+{
+    bool rc = false;
+
+    mark_connection_required(params);
+    params.mark_required(ClientParameters::KEY_SECRET);
+
+    params.check_required();
+
+    CharBuffer& action = params.get_value(ClientParameters::KEY_ACTION);
+    CharBuffer& nodelist = params.get_value(ClientParameters::KEY_NODELIST);
+    CharBuffer& secret = params.get_value(ClientParameters::KEY_SECRET);
+
+    // Split the node list into null-terminated node names, skipping empty entries
+    const size_t nodelist_length = nodelist.length();
+    const char* const nodelist_data = nodelist.c_str();
+    std::unique_ptr<char[]> name_buffer_mgr(new char[nodelist_length + 1]);
+    char* const name_buffer = name_buffer_mgr.get();
+    std::unique_ptr<const char*[]> nodename_list_mgr(new const char*[protocol::MAX_BATCH_NODES]);
+    const char** const nodename_list = nodename_list_mgr.get();
+    size_t node_count = 0;
+    size_t name_start = 0;
+    for (size_t idx = 0; idx <= nodelist_length; ++idx)
+    {
+        if (idx == nodelist_length || nodelist_data[idx] == ClientParameters::NODELIST_SPLIT_CHAR)
+        {
+            name_buffer[idx] = '\0';
+            if (idx > name_start)
+            {
+                if (node_count >= protocol::MAX_BATCH_NODES)
+                {
+                    std::string error_msg("The node list contains more than ");
+                    error_msg += std::to_string(protocol::MAX_BATCH_NODES);
+                    error_msg += " nodes";
+                    throw ClientException(error_msg);
+                }
+                nodename_list[node_count] = &(name_buffer[name_start]);
+                ++node_count;
+            }
+            name_start = idx + 1;
+        }
+        else
+        {
+            name_buffer[idx] = nodelist_data[idx];
+        }
+    }
+    if (node_count == 0)
+    {
+        throw ClientException("The node list does not contain any node names");
+    }
+
+    std::unique_ptr<bool[]> result_list_mgr(new bool[node_count]);
+    bool* const result_list = result_list_mgr.get();
+
+    std::unique_ptr<ClientConnector> connector_mgr = init_connector(params);
+    ClientConnector& connector = *connector_mgr;
+
+    if (action == ClientParameters::ACTION_OFF)
+    {
+        rc = connector.fence_batch_off(nodename_list, node_count, result_list, secret);
+    }
+    else
+    if (action == ClientParameters::ACTION_ON)
+    {
+        rc = connector.fence_batch_on(nodename_list, node_count, result_list, secret);
+    }
+    else
+    if (action == ClientParameters::ACTION_REBOOT)
+    {
+        rc = connector.fence_batch_reboot(nodename_list, node_count, result_list, secret);
+    }
+    else
+    {
+        std::string error_msg("Logic error: fence_batch_action(...) called with invalid action \"");
+        error_msg += action.c_str();
+        error_msg += "\"";
+        throw ClientException(error_msg);
+    }
+
+    connector.disconnect_from_server();
+
+    for (size_t idx = 0; idx < node_count; ++idx)
+    {
+        std::cout << "Node " << nodename_list[idx] << ": " <<
+            (result_list[idx] ? "Action successful" : "Action failed") << std::endl;
+    }
+
+    return rc;
+}
+
 int main(int argc, char* argv[])
 {
     int rc = static_cast<int> (Client::ExitCode::FENCING_FAILURE);
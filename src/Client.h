@@ -42,12 +42,19 @@ class Client
     // @throws std::bad_alloc, OsException, InetException, ClientException, ArgumentsException
     std::unique_ptr<ClientConnector> init_connector(ClientParameters& params);
 
+    // Marks the parameters that are required for connecting to the server
+    void mark_connection_required(ClientParameters& params);
+
     // @throws std::bad_alloc, OsException, InetException, ClientException, ProtocolException, ArgumentsException
     bool check_server_connection(ClientParameters& params);
 
     // @throws std::bad_alloc, OsException, InetException, ClientException, ProtocolException, ArgumentsException
     bool fence_action(ClientParameters& params);
 
+    // Fences all nodes of the node list with a single request
+    // @throws std::bad_alloc, OsException, InetException, ClientException, ProtocolException, ArgumentsException
+    bool fence_batch_action(ClientParameters& params);
+
     void output_metadata();
 };
 
@@ -1,5 +1,8 @@
 #include "ClientConnector.h"
 
+#include <string>
+#include <algorithm>
+
 #include "ip_parse.h"
 #include "zero_memory.h"
 #include "exceptions.h"
@@ -9,14 +12,16 @@ extern "C"
     #include <errno.h>
 }
 
-const size_t ClientConnector::IO_BUFFER_SIZE = 1024;
+const size_t ClientConnector::IO_BUFFER_SIZE      = 1024;
+const size_t ClientConnector::RECV_BUFFER_SIZE    = 4096;
 
 // @throws std::bad_alloc, InetException
 ClientConnector::ClientConnector(
     const CharBuffer& protocol_string,
     const CharBuffer& ip_string,
     const CharBuffer& port_string
-)
+):
+    recv_buffer(RECV_BUFFER_SIZE)
 {
     init_socket_address(protocol_string, ip_string, port_string, socket_domain, address_mgr, address, address_length);
 
@@ -29,9 +34,16 @@ ClientConnector::~ClientConnector() noexcept
     sys::close_fd(socket_fd);
 }
 
+socket_setup::Tuning& ClientConnector::get_socket_tuning() noexcept
+{
+    return socket_tuning;
+}
+
 // @throws InetException, OsException
 void ClientConnector::connect_to_server()
 {
+    disconnect_from_server();
+
     // Allocate socket file descriptor
     socket_fd = socket(socket_domain, SOCK_STREAM, 0);
     if (socket_fd < 0)
@@ -39,7 +51,7 @@ void ClientConnector::connect_to_server()
         throw InetException(InetException::ErrorId::SOCKET_ERROR);
     }
 
-    // Bind the socket to a local address
+    // Bind an IP socket to a local address
     if (socket_domain == AF_INET6)
     {
         struct sockaddr_in6 local_address;
@@ -76,10 +88,20 @@ void ClientConnector::connect_to_server()
         }
     }
     else
+    if (socket_domain == AF_UNIX)
+    {
+        // No local address, the server authenticates the connection by the peer credentials
+    }
+    else
     {
         throw InetException(InetException::ErrorId::UNKNOWN_AF);
     }
 
+    if (socket_domain != AF_UNIX)
+    {
+        socket_tuning.tune_connection(socket_fd, true);
+    }
+
     // Connect to the selected peer
     if (connect(socket_fd, address, address_length) != 0)
     {
@@ -104,9 +126,37 @@ void ClientConnector::connect_to_server()
     }
 }
 
+// @throws InetException, OsException
+void ClientConnector::ensure_connection()
+{
+    if (socket_fd == sys::FD_NONE || !is_connection_alive())
+    {
+        connect_to_server();
+    }
+}
+
 void ClientConnector::disconnect_from_server() noexcept
 {
     sys::close_fd(socket_fd);
+    recv_buffer.clear();
+}
+
+bool ClientConnector::is_connection_alive() noexcept
+{
+    // There is no pending data on an idle connection, unless the server closed the connection,
+    // in which case the end of stream (or an error) is pending
+    if (recv_buffer.get_length() > 0)
+    {
+        return false;
+    }
+    char peek_byte;
+    ssize_t peek_size = 0;
+    do
+    {
+        peek_size = recv(socket_fd, &peek_byte, 1, MSG_PEEK | MSG_DONTWAIT);
+    }
+    while (peek_size == -1 && errno == EINTR);
+    return peek_size == -1 && (errno == EAGAIN || errno == EWOULDBLOCK);
 }
 
 void ClientConnector::clear_io_buffer() noexcept
@@ -117,6 +167,8 @@ void ClientConnector::clear_io_buffer() noexcept
 // @throws InetException, OsException
 bool ClientConnector::check_connection()
 {
+    ensure_connection();
+
     header.set_msg_type(protocol::MsgType::ECHO_REQUEST);
     header.data_length = MsgHeader::HEADER_SIZE;
 
@@ -166,6 +218,7 @@ bool ClientConnector::fence_action_impl(
     protocol::write_field(io_buffer, IO_BUFFER_SIZE, offset, secret_param);
     header.data_length = static_cast<uint16_t> (offset);
 
+    ensure_connection();
     send_message();
 
     receive_message();
@@ -184,6 +237,115 @@ bool ClientConnector::fence_action_impl(
     return rc;
 }
 
+// @throws std::bad_alloc, InetException, OsException, ProtocolException
+bool ClientConnector::fence_batch_off(
+    const char* const* const nodename_list,
+    const size_t node_count,
+    bool* const result_list,
+    const CharBuffer& secret
+)
+{
+    return fence_batch_impl(protocol::MsgType::FENCE_OFF_BATCH, nodename_list, node_count, result_list, secret);
+}
+
+// @throws std::bad_alloc, InetException, OsException, ProtocolException
+bool ClientConnector::fence_batch_on(
+    const char* const* const nodename_list,
+    const size_t node_count,
+    bool* const result_list,
+    const CharBuffer& secret
+)
+{
+    return fence_batch_impl(protocol::MsgType::FENCE_ON_BATCH, nodename_list, node_count, result_list, secret);
+}
+
+// @throws std::bad_alloc, InetException, OsException, ProtocolException
+bool ClientConnector::fence_batch_reboot(
+    const char* const* const nodename_list,
+    const size_t node_count,
+    bool* const result_list,
+    const CharBuffer& secret
+)
+{
+    return fence_batch_impl(protocol::MsgType::FENCE_REBOOT_BATCH, nodename_list, node_count, result_list, secret);
+}
+
+// @throws InetException, OsException, ProtocolException
+bool ClientConnector::fence_batch_impl(
+    const protocol::MsgType& msg_type,
+    const char* const* const nodename_list,
+    const size_t node_count,
+    bool* const result_list,
+    const CharBuffer& secret
+)
+{
+    if (node_count == 0 || node_count > protocol::MAX_BATCH_NODES)
+    {
+        throw ProtocolException();
+    }
+
+    clear_io_buffer();
+    header.set_msg_type(msg_type);
+    size_t offset = MsgHeader::HEADER_SIZE;
+    for (size_t idx = 0; idx < node_count; ++idx)
+    {
+        std::string nodename_param(protocol::NODENAME);
+        nodename_param += protocol::KEY_VALUE_SPLIT_SEQ.c_str();
+        nodename_param += nodename_list[idx];
+        protocol::write_field(io_buffer, IO_BUFFER_SIZE, offset, nodename_param);
+    }
+
+    std::string secret_param(protocol::SECRET);
+    secret_param += protocol::KEY_VALUE_SPLIT_SEQ.c_str();
+    secret_param += secret.c_str();
+    protocol::write_field(io_buffer, IO_BUFFER_SIZE, offset, secret_param);
+    header.data_length = static_cast<uint16_t> (offset);
+
+    ensure_connection();
+    send_message();
+
+    receive_message();
+
+    if (!header.is_msg_type(protocol::MsgType::FENCE_BATCH_RESULT))
+    {
+        throw ProtocolException();
+    }
+
+    bool have_results = false;
+    size_t field_offset = MsgHeader::HEADER_SIZE;
+    const size_t data_length = std::min(static_cast<size_t> (header.data_length), IO_BUFFER_SIZE);
+    while (field_offset < data_length)
+    {
+        std::string key;
+        std::string value;
+        protocol::read_field(io_buffer, data_length, field_offset, key);
+        protocol::split_key_value_pair(key, value);
+        if (key == protocol::RESULTS)
+        {
+            if (value.length() != node_count)
+            {
+                throw ProtocolException();
+            }
+            for (size_t idx = 0; idx < node_count; ++idx)
+            {
+                result_list[idx] = value[idx] == protocol::RESULT_SUCCESS;
+            }
+            have_results = true;
+        }
+    }
+    if (!have_results)
+    {
+        throw ProtocolException();
+    }
+
+    bool rc = true;
+    for (size_t idx = 0; idx < node_count; ++idx)
+    {
+        rc = rc && result_list[idx];
+    }
+    return rc;
+}
+
 // @throws InetException, OsException
 void ClientConnector::send_message()
 {
@@ -200,16 +362,17 @@ void ClientConnector::send_message()
             socket_fd,
             &(io_buffer[io_offset]),
             req_write_size,
-            0 // Flags
+            MSG_NOSIGNAL
         );
         if (write_size > 0)
         {
             io_offset += static_cast<size_t> (write_size);
         }
         else
-        if (write_size == -1)
+        if (write_size == 0 || errno != EINTR)
         {
             disconnect_from_server();
+            throw OsException(OsException::ErrorId::IO_ERROR);
         }
     }
     if (io_offset < header.data_length)
@@ -224,38 +387,35 @@ void ClientConnector::receive_message()
     header.clear();
     clear_io_buffer();
 
+    // Each recv() call receives as much data as the server has sent, which remains in the receive buffer
+    // beyond the end of the message
     bool have_header = false;
-    size_t io_offset = 0;
-    size_t receive_length = MsgHeader::HEADER_SIZE;
-    while (io_offset < receive_length)
+    size_t frame_length = MsgHeader::HEADER_SIZE;
+    while (!have_header || recv_buffer.get_length() < frame_length)
     {
-        const size_t req_read_size = receive_length - io_offset;
-        const ssize_t read_size = recv(
-            socket_fd,
-            &(io_buffer[io_offset]),
-            req_read_size,
-            0 // Flags
-        );
-        if (read_size > 0)
+        if (!have_header && recv_buffer.get_length() >= MsgHeader::HEADER_SIZE)
         {
-            io_offset += read_size;
+            recv_buffer.peek(io_buffer, MsgHeader::HEADER_SIZE);
+            header.deserialize(io_buffer);
+            have_header = true;
 
-            if (!have_header && io_offset >= MsgHeader::HEADER_SIZE)
+            if (header.data_length > IO_BUFFER_SIZE)
             {
-                header.deserialize(io_buffer);
-                have_header = true;
-
-                receive_length = std::min(static_cast<size_t> (header.data_length), IO_BUFFER_SIZE);
+                disconnect_from_server();
+                throw OsException(OsException::ErrorId::IO_ERROR);
             }
+            frame_length = std::max(static_cast<size_t> (header.data_length), MsgHeader::HEADER_SIZE);
         }
         else
-        if (read_size == -1)
         {
-            disconnect_from_server();
+            const ssize_t read_size = recv_buffer.receive(socket_fd, 0);
+            if (read_size == 0 || (read_size < 0 && errno != EINTR))
+            {
+                // End of stream or I/O error
+                disconnect_from_server();
+                throw OsException(OsException::ErrorId::IO_ERROR);
+            }
         }
     }
-    if (!have_header || io_offset < header.data_length)
-    {
-        throw OsException(OsException::ErrorId::IO_ERROR);
-    }
+    recv_buffer.read(io_buffer, frame_length);
 }
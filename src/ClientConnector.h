@@ -5,6 +5,8 @@
 
 #include "MsgHeader.h"
 #include "Shared.h"
+#include "socket_setup.h"
+#include "RingBuffer.h"
 
 extern "C"
 {
@@ -16,6 +18,7 @@ class ClientConnector
 {
   public:
     static const size_t IO_BUFFER_SIZE;
+    static const size_t RECV_BUFFER_SIZE;
 
     // @throws std::bad_alloc, InetException
     ClientConnector(
@@ -24,14 +27,23 @@ class ClientConnector
         const CharBuffer& port_string
     );
     virtual ~ClientConnector() noexcept;
-    ClientConnector(const ClientConnector& other) = default;
-    ClientConnector(ClientConnector&& orig) = default;
-    virtual ClientConnector& operator=(const ClientConnector& other) = default;
-    virtual ClientConnector& operator=(ClientConnector&& orig) = default;
+    ClientConnector(const ClientConnector& other) = delete;
+    ClientConnector(ClientConnector&& orig) = delete;
+    virtual ClientConnector& operator=(const ClientConnector& other) = delete;
+    virtual ClientConnector& operator=(ClientConnector&& orig) = delete;
 
+    // Socket options that are applied to new connections to the server
+    virtual socket_setup::Tuning& get_socket_tuning() noexcept;
+
+    // Establishes a new connection to the server, closing the current connection, if any
     // @throws InetException, OsException
     virtual void connect_to_server();
 
+    // Connects to the server unless the current connection is still usable, so that a single
+    // connection can be reused for multiple requests
+    // @throws InetException, OsException
+    virtual void ensure_connection();
+
     virtual void disconnect_from_server() noexcept;
 
     virtual void clear_io_buffer() noexcept;
@@ -48,6 +60,34 @@ class ClientConnector
     // @throws InetException, OsException, ProtocolException
     virtual bool fence_action_reboot(const CharBuffer& nodename, const CharBuffer& secret);
 
+    // Batch fencing actions execute the fencing action for multiple nodes with a single request
+    // nodename_list contains node_count null-terminated node names, the result of the fencing action
+    // for each node is stored in the corresponding element of result_list
+    // Returns true if the fencing action was successful for all nodes
+    // @throws InetException, OsException, ProtocolException
+    virtual bool fence_batch_off(
+        const char* const* nodename_list,
+        size_t node_count,
+        bool* result_list,
+        const CharBuffer& secret
+    );
+
+    // @throws InetException, OsException, ProtocolException
+    virtual bool fence_batch_on(
+        const char* const* nodename_list,
+        size_t node_count,
+        bool* result_list,
+        const CharBuffer& secret
+    );
+
+    // @throws InetException, OsException, ProtocolException
+    virtual bool fence_batch_reboot(
+        const char* const* nodename_list,
+        size_t node_count,
+        bool* result_list,
+        const CharBuffer& secret
+    );
+
     // @throws InetException, OsException
     virtual void send_message();
 
@@ -66,12 +106,29 @@ class ClientConnector
     int                 socket_domain   = AF_INET6;
     int                 socket_fd       = sys::FD_NONE;
 
+    socket_setup::Tuning    socket_tuning;
+
+    // Data received from the server that has not been consumed by receive_message() yet
+    RingBuffer              recv_buffer;
+
+    // Returns false if the server closed the connection, e.g. because the connection was idle
+    bool is_connection_alive() noexcept;
+
     // @throws InetException, OsException, ProtocolException
     bool fence_action_impl(
         const protocol::MsgType& msg_type,
         const CharBuffer& nodename,
         const CharBuffer& secret
     );
+
+    // @throws InetException, OsException, ProtocolException
+    bool fence_batch_impl(
+        const protocol::MsgType& msg_type,
+        const char* const* nodename_list,
+        size_t node_count,
+        bool* result_list,
+        const CharBuffer& secret
+    );
 };
 
 #endif /* CLIENTCONNECTOR_H */
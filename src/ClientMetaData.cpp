@@ -19,18 +19,18 @@ namespace metadata
         "    <parameter name=\"protocol\" unique=\"1\" required=\"1\">\n"
         "      <content type=\"string\"/>\n"
         "      <shortdesc lang=\"en\">\n"
-        "        Protocol for the connection to the Universal Fencing Hub server: IPV4, IPV6\n"
+        "        Protocol for the connection to the Universal Fencing Hub server: IPV4, IPV6, UNIX\n"
         "      </shortdesc>\n"
         "    </parameter>\n"
         "    <parameter name=\"ip_address\" unique=\"1\" required=\"1\">\n"
         "      <content type=\"string\"/>\n"
         "      <shortdesc lang=\"en\">\n"
-        "        IP address of the Universal Fencing Hub server\n"
+        "        IP address of the Universal Fencing Hub server, or the path of its socket if the protocol is UNIX\n"
         "      </shortdesc>\n"
         "    </parameter>\n"
-        "    <parameter name=\"tcp_port\" unique=\"1\" required=\"1\">\n"
+        "    <parameter name=\"tcp_port\" unique=\"1\" required=\"0\">\n"
         "      <content type=\"string\"/>\n"
-        "        TCP port address of the Universal Fencing Hub server\n"
+        "        TCP port address of the Universal Fencing Hub server, not used if the protocol is UNIX\n"
         "      <shortdesc lang=\"en\">\n"
         "      </shortdesc>\n"
         "    </parameter>\n"
@@ -40,6 +40,66 @@ namespace metadata
         "        Password for sign in to the Univseral Fencing Hub server\n"
         "      </shortdesc>\n"
         "    </parameter>\n"
+        "    <parameter name=\"nodelist\" unique=\"0\" required=\"0\">\n"
+        "      <content type=\"string\"/>\n"
+        "      <shortdesc lang=\"en\">\n"
+        "        Comma-separated list of nodes to fence with a single request, instead of a single nodename\n"
+        "      </shortdesc>\n"
+        "    </parameter>\n"
+        "    <parameter name=\"tcp_nodelay\" unique=\"1\" required=\"0\">\n"
+        "      <content type=\"string\"/>\n"
+        "      <shortdesc lang=\"en\">\n"
+        "        Disable Nagle's algorithm on the connection to the server: 1 (default) or 0\n"
+        "      </shortdesc>\n"
+        "    </parameter>\n"
+        "    <parameter name=\"tcp_quickack\" unique=\"1\" required=\"0\">\n"
+        "      <content type=\"string\"/>\n"
+        "      <shortdesc lang=\"en\">\n"
+        "        Acknowledge received data immediately: 1 or 0 (default)\n"
+        "      </shortdesc>\n"
+        "    </parameter>\n"
+        "    <parameter name=\"tcp_fastopen\" unique=\"1\" required=\"0\">\n"
+        "      <content type=\"string\"/>\n"
+        "      <shortdesc lang=\"en\">\n"
+        "        Use TCP fast open for the connection to the server: 1 or 0 (default)\n"
+        "      </shortdesc>\n"
+        "    </parameter>\n"
+        "    <parameter name=\"so_rcvbuf\" unique=\"1\" required=\"0\">\n"
+        "      <content type=\"string\"/>\n"
+        "      <shortdesc lang=\"en\">\n"
+        "        Socket receive buffer size in bytes, 0 for the system default\n"
+        "      </shortdesc>\n"
+        "    </parameter>\n"
+        "    <parameter name=\"so_sndbuf\" unique=\"1\" required=\"0\">\n"
+        "      <content type=\"string\"/>\n"
+        "      <shortdesc lang=\"en\">\n"
+        "        Socket send buffer size in bytes, 0 for the system default\n"
+        "      </shortdesc>\n"
+        "    </parameter>\n"
+        "    <parameter name=\"tcp_keepidle\" unique=\"1\" required=\"0\">\n"
+        "      <content type=\"string\"/>\n"
+        "      <shortdesc lang=\"en\">\n"
+        "        Seconds of idle time before sending keepalive probes, 0 disables keepalive\n"
+        "      </shortdesc>\n"
+        "    </parameter>\n"
+        "    <parameter name=\"tcp_keepintvl\" unique=\"1\" required=\"0\">\n"
+        "      <content type=\"string\"/>\n"
+        "      <shortdesc lang=\"en\">\n"
+        "        Seconds between keepalive probes, 0 for the system default\n"
+        "      </shortdesc>\n"
+        "    </parameter>\n"
+        "    <parameter name=\"tcp_keepcnt\" unique=\"1\" required=\"0\">\n"
+        "      <content type=\"string\"/>\n"
+        "      <shortdesc lang=\"en\">\n"
+        "        Number of unanswered keepalive probes before the connection is dropped, 0 for the system default\n"
+        "      </shortdesc>\n"
+        "    </parameter>\n"
+        "    <parameter name=\"tcp_user_timeout\" unique=\"1\" required=\"0\">\n"
+        "      <content type=\"string\"/>\n"
+        "      <shortdesc lang=\"en\">\n"
+        "        Milliseconds that transmitted data may remain unacknowledged, 0 for the system default\n"
+        "      </shortdesc>\n"
+        "    </parameter>\n"
         "  </parameters>\n"
         "  <actions>\n"
         "    <action name=\"off\"/>\n"
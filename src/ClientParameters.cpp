@@ -11,6 +11,16 @@ const char* const ClientParameters::KEY_IP_ADDRESS("ip_address");
 const char* const ClientParameters::KEY_TCP_PORT("tcp_port");
 const char* const ClientParameters::KEY_SECRET("secret");
 const char* const ClientParameters::KEY_NODENAME("nodename");
+const char* const ClientParameters::KEY_NODELIST("nodelist");
+const char* const ClientParameters::KEY_TCP_NODELAY("tcp_nodelay");
+const char* const ClientParameters::KEY_TCP_QUICKACK("tcp_quickack");
+const char* const ClientParameters::KEY_TCP_FASTOPEN("tcp_fastopen");
+const char* const ClientParameters::KEY_SO_RCVBUF("so_rcvbuf");
+const char* const ClientParameters::KEY_SO_SNDBUF("so_sndbuf");
+const char* const ClientParameters::KEY_TCP_KEEPIDLE("tcp_keepidle");
+const char* const ClientParameters::KEY_TCP_KEEPINTVL("tcp_keepintvl");
+const char* const ClientParameters::KEY_TCP_KEEPCNT("tcp_keepcnt");
+const char* const ClientParameters::KEY_TCP_USER_TIMEOUT("tcp_user_timeout");
 
 const char* const ClientParameters::ACTION_OFF("off");
 const char* const ClientParameters::ACTION_ON("on");
@@ -22,6 +32,8 @@ const char* const ClientParameters::ACTION_MONITOR("monitor");
 const char* const ClientParameters::ACTION_START("start");
 const char* const ClientParameters::ACTION_STOP("stop");
 
+const char ClientParameters::NODELIST_SPLIT_CHAR = ',';
+
 const size_t ClientParameters::MAX_PARAMETER_SIZE = 512;
 
 ClientParameters::ClientParameters()
@@ -40,7 +52,17 @@ void ClientParameters::initialize()
     add_entry(KEY_IP_ADDRESS, constraints::IP_ADDR_PARAM_SIZE);
     add_entry(KEY_TCP_PORT, constraints::PORT_PARAM_SIZE);
     add_entry(KEY_NODENAME, constraints::NODENAME_PARAM_SIZE);
+    add_entry(KEY_NODELIST, constraints::NODELIST_PARAM_SIZE);
     add_entry(KEY_SECRET, constraints::SECRET_PARAM_SIZE);
+    add_entry(KEY_TCP_NODELAY, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_QUICKACK, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_FASTOPEN, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_SO_RCVBUF, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_SO_SNDBUF, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_KEEPIDLE, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_KEEPINTVL, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_KEEPCNT, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_USER_TIMEOUT, constraints::COUNT_PARAM_SIZE);
 
     mark_required(KEY_ACTION);
 }
@@ -77,3 +99,26 @@ void ClientParameters::read_parameters()
         throw OsException(OsException::ErrorId::IO_ERROR);
     }
 }
+
+// @throws std::bad_alloc, ArgumentsException
+void ClientParameters::get_socket_tuning(socket_setup::Tuning& tuning)
+{
+    using Tuning = socket_setup::Tuning;
+    tuning.nodelay = get_count_value(KEY_TCP_NODELAY, 1, 0, 1) != 0;
+    tuning.quickack = get_count_value(KEY_TCP_QUICKACK, 0, 0, 1) != 0;
+    tuning.fastopen = static_cast<uint32_t> (get_count_value(KEY_TCP_FASTOPEN, 0, 0, Tuning::MAX_FASTOPEN_QUEUE));
+    tuning.recv_buffer_size = static_cast<uint32_t> (get_count_value(KEY_SO_RCVBUF, 0, 0, Tuning::MAX_BUFFER_SIZE));
+    tuning.send_buffer_size = static_cast<uint32_t> (get_count_value(KEY_SO_SNDBUF, 0, 0, Tuning::MAX_BUFFER_SIZE));
+    tuning.keepalive_idle = static_cast<uint32_t> (
+        get_count_value(KEY_TCP_KEEPIDLE, 0, 0, Tuning::MAX_KEEPALIVE_IDLE)
+    );
+    tuning.keepalive_interval = static_cast<uint32_t> (
+        get_count_value(KEY_TCP_KEEPINTVL, 0, 0, Tuning::MAX_KEEPALIVE_INTERVAL)
+    );
+    tuning.keepalive_count = static_cast<uint32_t> (
+        get_count_value(KEY_TCP_KEEPCNT, 0, 0, Tuning::MAX_KEEPALIVE_COUNT)
+    );
+    tuning.user_timeout = static_cast<uint32_t> (
+        get_count_value(KEY_TCP_USER_TIMEOUT, 0, 0, Tuning::MAX_USER_TIMEOUT)
+    );
+}
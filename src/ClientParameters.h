@@ -3,6 +3,7 @@
 
 #include <CharBuffer.h>
 #include "Arguments.h"
+#include "socket_setup.h"
 
 class ClientParameters : public Arguments
 {
@@ -13,6 +14,16 @@ class ClientParameters : public Arguments
     static const char* const KEY_TCP_PORT;
     static const char* const KEY_SECRET;
     static const char* const KEY_NODENAME;
+    static const char* const KEY_NODELIST;
+    static const char* const KEY_TCP_NODELAY;
+    static const char* const KEY_TCP_QUICKACK;
+    static const char* const KEY_TCP_FASTOPEN;
+    static const char* const KEY_SO_RCVBUF;
+    static const char* const KEY_SO_SNDBUF;
+    static const char* const KEY_TCP_KEEPIDLE;
+    static const char* const KEY_TCP_KEEPINTVL;
+    static const char* const KEY_TCP_KEEPCNT;
+    static const char* const KEY_TCP_USER_TIMEOUT;
 
     static const char* const ACTION_OFF;
     static const char* const ACTION_ON;
@@ -24,6 +35,8 @@ class ClientParameters : public Arguments
     static const char* const ACTION_START;
     static const char* const ACTION_STOP;
 
+    static const char NODELIST_SPLIT_CHAR;
+
     static const size_t MAX_PARAMETER_SIZE;
 
     ClientParameters();
@@ -38,6 +51,11 @@ class ClientParameters : public Arguments
 
     // @throws std::bad_alloc, OsException, ArgumentsException
     virtual void read_parameters();
+
+    // Reads the socket options selected by the optional socket tuning parameters
+    // TCP_NODELAY is enabled by default, all other options are left at the system's defaults by default
+    // @throws std::bad_alloc, ArgumentsException
+    virtual void get_socket_tuning(socket_setup::Tuning& tuning);
 };
 
 #endif /* CLIENTPARAMETERS_H */
@@ -0,0 +1,19 @@
+#include "Endpoint.h"
+#include "Shared.h"
+
+// @throws std::bad_alloc
+Endpoint::Endpoint():
+    protocol(constraints::PROTOCOL_PARAM_SIZE),
+    address(constraints::IP_ADDR_PARAM_SIZE),
+    port(constraints::PORT_PARAM_SIZE)
+{
+}
+
+Endpoint::~Endpoint() noexcept
+{
+}
+
+bool Endpoint::is_unix_socket() const
+{
+    return protocol == keyword::PROTO_UNIX;
+}
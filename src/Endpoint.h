@@ -0,0 +1,27 @@
+#ifndef ENDPOINT_H
+#define ENDPOINT_H
+
+#include <CharBuffer.h>
+
+// Protocol, address and port of a server socket
+//
+// For unix domain sockets, the address is the path of the socket and the port is not used
+class Endpoint
+{
+  public:
+    CharBuffer  protocol;
+    CharBuffer  address;
+    CharBuffer  port;
+
+    // @throws std::bad_alloc
+    Endpoint();
+    virtual ~Endpoint() noexcept;
+    Endpoint(const Endpoint& other) = delete;
+    Endpoint(Endpoint&& orig) = delete;
+    virtual Endpoint& operator=(const Endpoint& other) = delete;
+    virtual Endpoint& operator=(Endpoint&& orig) = delete;
+
+    virtual bool is_unix_socket() const;
+};
+
+#endif /* ENDPOINT_H */
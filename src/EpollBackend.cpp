@@ -0,0 +1,134 @@
+#include "EpollBackend.h"
+#include "exceptions.h"
+
+#include <algorithm>
+
+extern "C"
+{
+    #include <errno.h>
+}
+
+const size_t EpollBackend::EVENT_BUFFER_SIZE = 256;
+
+// @throws std::bad_alloc
+EpollBackend::EpollBackend()
+{
+    epoll_events_mgr = std::unique_ptr<struct epoll_event[]>(new struct epoll_event[EVENT_BUFFER_SIZE]);
+    epoll_events = epoll_events_mgr.get();
+}
+
+EpollBackend::~EpollBackend() noexcept
+{
+    sys::close_fd(epoll_fd);
+}
+
+// @throws OsException
+void EpollBackend::init()
+{
+    sys::close_fd(epoll_fd);
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0)
+    {
+        throw OsException(OsException::ErrorId::SELECTOR_ERROR);
+    }
+}
+
+// @throws OsException
+void EpollBackend::register_fd(const int fd, const Interest interest, Target* const target)
+{
+    if (interest != Interest::NONE)
+    {
+        struct epoll_event fd_event;
+        fd_event.events = interest_to_events(interest);
+        fd_event.data.ptr = target;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &fd_event) != 0)
+        {
+            throw OsException(OsException::ErrorId::SELECTOR_ERROR);
+        }
+    }
+}
+
+// @throws OsException
+void EpollBackend::modify_fd(const int fd, const Interest interest, Target* const target)
+{
+    if (interest != Interest::NONE)
+    {
+        struct epoll_event fd_event;
+        fd_event.events = interest_to_events(interest);
+        fd_event.data.ptr = target;
+        int rc = epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &fd_event);
+        if (rc != 0 && errno == ENOENT)
+        {
+            // Not in the epoll set due to a previous Interest::NONE
+            rc = epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &fd_event);
+        }
+        if (rc != 0)
+        {
+            throw OsException(OsException::ErrorId::SELECTOR_ERROR);
+        }
+    }
+    else
+    {
+        unregister_fd(fd);
+    }
+}
+
+void EpollBackend::unregister_fd(const int fd) noexcept
+{
+    // Failure due to the file descriptor not being in the epoll set is ignored
+    struct epoll_event fd_event;
+    fd_event.events = 0;
+    fd_event.data.ptr = nullptr;
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, &fd_event);
+}
+
+// @throws OsException
+size_t EpollBackend::wait(Event* const events, const size_t events_capacity, const int timeout)
+{
+    size_t event_count = 0;
+    const int max_events = static_cast<int> (std::min(events_capacity, EVENT_BUFFER_SIZE));
+    const int wait_rc = epoll_wait(epoll_fd, epoll_events, max_events, timeout);
+    if (wait_rc > 0)
+    {
+        event_count = static_cast<size_t> (wait_rc);
+        for (size_t idx = 0; idx < event_count; ++idx)
+        {
+            const uint32_t ready_flags = epoll_events[idx].events;
+            Event& ready_event = events[idx];
+            ready_event.target = static_cast<Target*> (epoll_events[idx].data.ptr);
+            ready_event.readable = (ready_flags & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0;
+            ready_event.writable = (ready_flags & (EPOLLOUT | EPOLLHUP | EPOLLERR)) != 0;
+        }
+    }
+    else
+    if (wait_rc == -1 && errno != EINTR)
+    {
+        throw OsException(OsException::ErrorId::IO_ERROR);
+    }
+    return event_count;
+}
+
+const char* EpollBackend::get_name() const noexcept
+{
+    return "epoll";
+}
+
+uint32_t EpollBackend::interest_to_events(const Interest interest) noexcept
+{
+    uint32_t events = 0;
+    if (interest == Interest::READ)
+    {
+        events = EPOLLIN;
+    }
+    else
+    if (interest == Interest::WRITE)
+    {
+        events = EPOLLOUT;
+    }
+    else
+    if (interest == Interest::READ_WRITE)
+    {
+        events = EPOLLIN | EPOLLOUT;
+    }
+    return events;
+}
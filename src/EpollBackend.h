@@ -0,0 +1,59 @@
+#ifndef EPOLLBACKEND_H
+#define EPOLLBACKEND_H
+
+#include <cstddef>
+#include <memory>
+
+#include "SelectorBackend.h"
+#include "Shared.h"
+
+extern "C"
+{
+    #include <sys/epoll.h>
+}
+
+// Selector backend based on epoll(7)
+// File descriptors are registered once and only interest changes are communicated to the kernel,
+// so that the cost of a wait depends on the number of ready file descriptors only.
+// File descriptors with Interest::NONE are removed from the epoll set, because epoll
+// reports hangup and error conditions even if no events are requested.
+class EpollBackend : public SelectorBackend
+{
+  public:
+    static const size_t EVENT_BUFFER_SIZE;
+
+  private:
+    int                                 epoll_fd        = sys::FD_NONE;
+    std::unique_ptr<struct epoll_event[]> epoll_events_mgr;
+    struct epoll_event*                 epoll_events    = nullptr;
+
+  public:
+    // @throws std::bad_alloc
+    EpollBackend();
+    virtual ~EpollBackend() noexcept;
+    EpollBackend(const EpollBackend& other) = delete;
+    EpollBackend(EpollBackend&& orig) = delete;
+    virtual EpollBackend& operator=(const EpollBackend& other) = delete;
+    virtual EpollBackend& operator=(EpollBackend&& orig) = delete;
+
+    // @throws OsException
+    virtual void init() override;
+
+    // @throws OsException
+    virtual void register_fd(int fd, Interest interest, Target* target) override;
+
+    // @throws OsException
+    virtual void modify_fd(int fd, Interest interest, Target* target) override;
+
+    virtual void unregister_fd(int fd) noexcept override;
+
+    // @throws OsException
+    virtual size_t wait(Event* events, size_t events_capacity, int timeout) override;
+
+    virtual const char* get_name() const noexcept override;
+
+  private:
+    static uint32_t interest_to_events(Interest interest) noexcept;
+};
+
+#endif /* EPOLLBACKEND_H */
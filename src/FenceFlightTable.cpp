@@ -0,0 +1,195 @@
+#include "FenceFlightTable.h"
+
+#include <cstring>
+
+FenceFlightTable::FenceFlightTable()
+{
+}
+
+FenceFlightTable::~FenceFlightTable() noexcept
+{
+}
+
+FenceFlightTable::Flight::Flight()
+{
+}
+
+FenceFlightTable::Flight::~Flight() noexcept
+{
+}
+
+// @throws std::bad_alloc
+void FenceFlightTable::enable_result_cache(const std::chrono::seconds ttl)
+{
+    result_cache_mgr = std::unique_ptr<FenceResultCache>(new FenceResultCache(ttl));
+    result_cache = result_cache_mgr.get();
+}
+
+bool FenceFlightTable::have_result_cache() const noexcept
+{
+    return result_cache != nullptr;
+}
+
+FenceFlightTable::Flight* FenceFlightTable::enter(
+    Flight* const flight,
+    const char* const nodename,
+    const size_t nodename_length,
+    const char* const action
+) noexcept
+{
+    std::unique_lock<std::mutex> lock(table_lock);
+
+    // Only the most recently entered flight affecting the node is a candidate for coalescing, because
+    // coalescing with an earlier flight would reorder the fencing action with the conflicting fencing
+    // actions that were entered later
+    Flight* last_flight = flight_queue.get_last();
+    while (last_flight != nullptr && !is_same_node(last_flight, nodename, nodename_length))
+    {
+        last_flight = last_flight->get_prev_node();
+    }
+
+    Flight* selected_flight = flight;
+    if (last_flight != nullptr && last_flight->action == action)
+    {
+        ++(last_flight->ref_count);
+        selected_flight = last_flight;
+    }
+    else
+    if (last_flight == nullptr && result_cache != nullptr &&
+        result_cache->lookup(nodename, nodename_length, action))
+    {
+        selected_flight = nullptr;
+    }
+    else
+    {
+        link_flight(flight, nodename, nodename_length, action, flight);
+    }
+    return selected_flight;
+}
+
+void FenceFlightTable::enter_group(
+    Flight* const flight_list,
+    const char* const* const nodename_list,
+    const size_t* const nodename_length_list,
+    const size_t node_count,
+    const char* const action
+) noexcept
+{
+    // All flights of the group are entered at once, so that the order of flights is the same for all nodes,
+    // and groups that affect the same nodes can not wait for each other
+    std::unique_lock<std::mutex> lock(table_lock);
+    for (size_t idx = 0; idx < node_count; ++idx)
+    {
+        link_flight(&(flight_list[idx]), nodename_list[idx], nodename_length_list[idx], action, flight_list);
+    }
+}
+
+bool FenceFlightTable::await_turn(Flight* const flight) noexcept
+{
+    bool waited = false;
+    std::unique_lock<std::mutex> lock(table_lock);
+    bool ready = false;
+    while (!ready)
+    {
+        Flight* prev_flight = flight->get_prev_node();
+        while (prev_flight != nullptr &&
+            (prev_flight->group == flight->group ||
+            !is_same_node(prev_flight, flight->nodename, flight->nodename_length)))
+        {
+            prev_flight = prev_flight->get_prev_node();
+        }
+        ready = prev_flight == nullptr;
+        if (!ready)
+        {
+            waited = true;
+            table_condition.wait(lock);
+        }
+    }
+    return waited;
+}
+
+void FenceFlightTable::complete(Flight* const flight, const bool success_flag) noexcept
+{
+    std::unique_lock<std::mutex> lock(table_lock);
+    if (result_cache != nullptr)
+    {
+        // If a conflicting fencing action affecting the same node was entered after this flight, the result
+        // is outdated as soon as that fencing action executes
+        Flight* next_flight = flight->get_next_node();
+        while (next_flight != nullptr &&
+            (next_flight->action == flight->action ||
+            !is_same_node(next_flight, flight->nodename, flight->nodename_length)))
+        {
+            next_flight = next_flight->get_next_node();
+        }
+        if (success_flag && next_flight == nullptr)
+        {
+            result_cache->store(flight->nodename, flight->nodename_length, flight->action);
+        }
+        else
+        {
+            result_cache->invalidate(flight->nodename, flight->nodename_length, nullptr);
+        }
+    }
+    flight->success_flag = success_flag;
+    flight->completed = true;
+    --(flight->ref_count);
+    flight_queue.remove(flight);
+    table_condition.notify_all();
+
+    // The flight is owned by the caller, it must remain valid until all waiting threads have received the result
+    while (flight->ref_count > 0)
+    {
+        table_condition.wait(lock);
+    }
+}
+
+bool FenceFlightTable::await_result(Flight* const flight) noexcept
+{
+    std::unique_lock<std::mutex> lock(table_lock);
+    while (!flight->completed)
+    {
+        table_condition.wait(lock);
+    }
+    const bool success_flag = flight->success_flag;
+    --(flight->ref_count);
+    if (flight->ref_count == 0)
+    {
+        table_condition.notify_all();
+    }
+    return success_flag;
+}
+
+// Caller must have locked the table_lock
+void FenceFlightTable::link_flight(
+    Flight* const flight,
+    const char* const nodename,
+    const size_t nodename_length,
+    const char* const action,
+    const Flight* const group
+) noexcept
+{
+    flight->nodename = nodename;
+    flight->nodename_length = nodename_length;
+    flight->action = action;
+    flight->group = group;
+    flight->ref_count = 1;
+    flight->completed = false;
+    flight->success_flag = false;
+    flight_queue.add_last(flight);
+
+    if (result_cache != nullptr)
+    {
+        result_cache->invalidate(nodename, nodename_length, action);
+    }
+}
+
+bool FenceFlightTable::is_same_node(
+    const Flight* const flight,
+    const char* const nodename,
+    const size_t nodename_length
+) noexcept
+{
+    return flight->nodename_length == nodename_length &&
+        std::memcmp(flight->nodename, nodename, nodename_length) == 0;
+}
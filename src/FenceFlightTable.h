@@ -0,0 +1,126 @@
+#ifndef FENCEFLIGHTTABLE_H
+#define FENCEFLIGHTTABLE_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+#include "Queue.h"
+#include "FenceResultCache.h"
+
+// Table of the fencing actions that are in progress or waiting for another fencing action affecting
+// the same node
+//
+// Fencing actions affecting the same node are executed in the order they were entered into the table.
+// A fencing action that is entered while the most recently entered fencing action affecting the same
+// node is the same action, e.g. a second OFF action while an OFF action is in progress, is coalesced
+// with that fencing action, so that the plugin is called only once and all requests receive its result.
+//
+// If the result cache is enabled, a fencing action that succeeded within the cache's time-to-live
+// period is not executed again, unless a conflicting fencing action affecting the same node was entered
+// in the meantime.
+//
+// Flights are owned by the threads that execute the fencing actions, the table only links them.
+// Since the number of fencing actions in progress is limited by the number of worker threads, the table
+// is searched linearly.
+class FenceFlightTable
+{
+  public:
+    class Flight : public Queue<Flight>::Node
+    {
+        friend class FenceFlightTable;
+
+      private:
+        const char*     nodename        = nullptr;
+        size_t          nodename_length = 0;
+        const char*     action          = nullptr;
+        // Flights that are part of the same plugin call, e.g. the nodes of a batch fencing action,
+        // never wait for each other
+        const Flight*   group           = nullptr;
+        // Number of threads waiting for the result, including the thread that executes the fencing action
+        size_t          ref_count       = 0;
+        bool            completed       = false;
+        bool            success_flag    = false;
+
+      public:
+        Flight();
+        virtual ~Flight() noexcept;
+        Flight(const Flight& other) = delete;
+        Flight(Flight&& orig) = delete;
+        virtual Flight& operator=(const Flight& other) = delete;
+        virtual Flight& operator=(Flight&& orig) = delete;
+    };
+
+    FenceFlightTable();
+    virtual ~FenceFlightTable() noexcept;
+    FenceFlightTable(const FenceFlightTable& other) = delete;
+    FenceFlightTable(FenceFlightTable&& orig) = delete;
+    virtual FenceFlightTable& operator=(const FenceFlightTable& other) = delete;
+    virtual FenceFlightTable& operator=(FenceFlightTable&& orig) = delete;
+
+    // Enables caching the results of successful fencing actions for the specified time-to-live period
+    // Must be called before any fencing actions are entered
+    // @throws std::bad_alloc
+    virtual void enable_result_cache(std::chrono::seconds ttl);
+    virtual bool have_result_cache() const noexcept;
+
+    // Enters a fencing action affecting a single node
+    // Returns the flight that the fencing action was coalesced with, or the caller's flight, which
+    // the caller must execute by calling await_turn() and complete(), or nullptr if the fencing action
+    // has succeeded recently and its result is cached
+    // The action must be one of the Server's action labels, which are compared by address
+    virtual Flight* enter(
+        Flight* flight,
+        const char* nodename,
+        size_t nodename_length,
+        const char* action
+    ) noexcept;
+
+    // Enters a fencing action affecting multiple nodes that are fenced by a single plugin call
+    // The flights are never coalesced with other flights, the caller must execute all of them
+    virtual void enter_group(
+        Flight* flight_list,
+        const char* const* nodename_list,
+        const size_t* nodename_length_list,
+        size_t node_count,
+        const char* action
+    ) noexcept;
+
+    // Waits until all fencing actions affecting the same node that were entered before the caller's
+    // flight have completed
+    // Returns true if the caller had to wait
+    virtual bool await_turn(Flight* flight) noexcept;
+
+    // Publishes the result of the caller's flight and removes it from the table
+    // Returns after all threads that were waiting for the result have received it
+    virtual void complete(Flight* flight, bool success_flag) noexcept;
+
+    // Waits until the flight that a fencing action was coalesced with completes
+    // Returns the result of the flight
+    virtual bool await_result(Flight* flight) noexcept;
+
+  private:
+    std::mutex              table_lock;
+    // Notified whenever a flight completes and whenever a thread receives the result of a flight
+    std::condition_variable table_condition;
+    // Flights in the order they were entered
+    Queue<Flight>           flight_queue;
+
+    std::unique_ptr<FenceResultCache>   result_cache_mgr;
+    FenceResultCache*                   result_cache    = nullptr;
+
+    // Caller must have locked the table_lock
+    void link_flight(
+        Flight* flight,
+        const char* nodename,
+        size_t nodename_length,
+        const char* action,
+        const Flight* group
+    ) noexcept;
+
+    static bool is_same_node(const Flight* flight, const char* nodename, size_t nodename_length) noexcept;
+};
+
+#endif /* FENCEFLIGHTTABLE_H */
@@ -0,0 +1,144 @@
+#include "FenceResultCache.h"
+
+#include <new>
+
+const size_t FenceResultCache::NODENAME_CAPACITY  = 255;
+
+// @throws std::bad_alloc
+FenceResultCache::FenceResultCache(const std::chrono::seconds entry_ttl):
+    ttl(entry_ttl),
+    entry_map_mgr(new EntryMap(&FenceResultCache::compare_keys)),
+    lookup_key(NODENAME_CAPACITY)
+{
+    entry_map = entry_map_mgr.get();
+}
+
+FenceResultCache::~FenceResultCache() noexcept
+{
+    entry_map->clear();
+    Entry* entry = expiry_queue.remove_first();
+    while (entry != nullptr)
+    {
+        delete entry;
+        entry = expiry_queue.remove_first();
+    }
+}
+
+// @throws std::bad_alloc
+FenceResultCache::Entry::Entry(const size_t nodename_capacity):
+    nodename(nodename_capacity)
+{
+}
+
+FenceResultCache::Entry::~Entry() noexcept
+{
+}
+
+bool FenceResultCache::lookup(const char* const nodename, const size_t nodename_length, const char* const action) noexcept
+{
+    purge_expired(std::chrono::steady_clock::now());
+    const Entry* const entry = find_entry(nodename, nodename_length);
+    return entry != nullptr && entry->action == action;
+}
+
+void FenceResultCache::invalidate(
+    const char* const nodename,
+    const size_t nodename_length,
+    const char* const action
+) noexcept
+{
+    Entry* const entry = find_entry(nodename, nodename_length);
+    if (entry != nullptr && (action == nullptr || entry->action != action))
+    {
+        remove_entry(entry);
+    }
+}
+
+void FenceResultCache::store(const char* const nodename, const size_t nodename_length, const char* const action) noexcept
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    purge_expired(now);
+    if (nodename_length <= NODENAME_CAPACITY)
+    {
+        Entry* entry = find_entry(nodename, nodename_length);
+        if (entry != nullptr)
+        {
+            // Renew the entry, which moves it to the tail of the expiry queue
+            expiry_queue.remove(entry);
+        }
+        else
+        {
+            try
+            {
+                std::unique_ptr<Entry> entry_mgr(new Entry(NODENAME_CAPACITY));
+                entry_mgr->nodename.append(nodename, nodename_length);
+                entry_map->insert(&(entry_mgr->nodename), entry_mgr.get());
+                entry = entry_mgr.release();
+            }
+            catch (std::bad_alloc&)
+            {
+                // The result is not cached
+            }
+        }
+
+        if (entry != nullptr)
+        {
+            entry->action = action;
+            entry->expiry_time = now + ttl;
+            expiry_queue.add_last(entry);
+        }
+    }
+}
+
+void FenceResultCache::purge_expired(const std::chrono::steady_clock::time_point now) noexcept
+{
+    Entry* entry = expiry_queue.get_first();
+    while (entry != nullptr && entry->expiry_time <= now)
+    {
+        remove_entry(entry);
+        entry = expiry_queue.get_first();
+    }
+}
+
+FenceResultCache::Entry* FenceResultCache::find_entry(const char* const nodename, const size_t nodename_length) noexcept
+{
+    Entry* entry = nullptr;
+    if (nodename_length <= NODENAME_CAPACITY)
+    {
+        lookup_key.clear();
+        lookup_key.append(nodename, nodename_length);
+        entry = entry_map->get(&lookup_key);
+    }
+    return entry;
+}
+
+void FenceResultCache::remove_entry(Entry* const entry) noexcept
+{
+    entry_map->remove(&(entry->nodename));
+    expiry_queue.remove(entry);
+    delete entry;
+}
+
+int FenceResultCache::compare_keys(const CharBuffer* const key, const CharBuffer* const other)
+{
+    int rc = 0;
+    if (key != nullptr)
+    {
+        if (other != nullptr)
+        {
+            rc = (*key).compare_to(*other);
+        }
+        else
+        {
+            rc = 1;
+        }
+    }
+    else
+    {
+        if (other != nullptr)
+        {
+            rc = -1;
+        }
+    }
+    return rc;
+}
@@ -0,0 +1,86 @@
+#ifndef FENCERESULTCACHE_H
+#define FENCERESULTCACHE_H
+
+#include <cstddef>
+#include <memory>
+#include <chrono>
+#include <dsaext.h>
+#include <QTree.h>
+#include <CharBuffer.h>
+
+#include "Queue.h"
+
+// Cache of the successful fencing actions of the last time-to-live period, keyed by node name
+//
+// Each node has at most one entry, because any fencing action that conflicts with the cached fencing action
+// invalidates the node's entry. Since the time-to-live is the same for all entries, the entries expire
+// in the order they were stored, and expired entries are removed from the head of the expiry queue.
+//
+// The cache is not thread-safe, it is used by the FenceFlightTable while the table is locked.
+class FenceResultCache
+{
+  public:
+    // @throws std::bad_alloc
+    FenceResultCache(std::chrono::seconds entry_ttl);
+    virtual ~FenceResultCache() noexcept;
+    FenceResultCache(const FenceResultCache& other) = delete;
+    FenceResultCache(FenceResultCache&& orig) = delete;
+    virtual FenceResultCache& operator=(const FenceResultCache& other) = delete;
+    virtual FenceResultCache& operator=(FenceResultCache&& orig) = delete;
+
+    // Returns true if the fencing action affecting the node has succeeded within the time-to-live period
+    // The action must be one of the Server's action labels, which are compared by address
+    virtual bool lookup(const char* nodename, size_t nodename_length, const char* action) noexcept;
+
+    // Removes the node's entry, unless it is an entry for the specified action
+    // If action is nullptr, the node's entry is removed unconditionally
+    virtual void invalidate(const char* nodename, size_t nodename_length, const char* action) noexcept;
+
+    // Stores the successful fencing action affecting the node, replacing any previous entry for the node
+    // If no entry can be allocated, the result is not cached
+    virtual void store(const char* nodename, size_t nodename_length, const char* action) noexcept;
+
+  private:
+    class Entry : public Queue<Entry>::Node
+    {
+      public:
+        CharBuffer                              nodename;
+        const char*                             action      = nullptr;
+        std::chrono::steady_clock::time_point   expiry_time;
+
+        // @throws std::bad_alloc
+        Entry(size_t nodename_capacity);
+        virtual ~Entry() noexcept;
+        Entry(const Entry& other) = delete;
+        Entry(Entry&& orig) = delete;
+        virtual Entry& operator=(const Entry& other) = delete;
+        virtual Entry& operator=(Entry&& orig) = delete;
+    };
+
+    using EntryMap = QTree<const CharBuffer, Entry>;
+
+    // Capacity of the node name buffers, node names of greater length are never cached
+    static const size_t NODENAME_CAPACITY;
+
+    std::chrono::steady_clock::duration ttl;
+
+    std::unique_ptr<EntryMap>   entry_map_mgr;
+    EntryMap*                   entry_map       = nullptr;
+    // Entries in the order they expire
+    Queue<Entry>                expiry_queue;
+
+    // Key for looking up entries without allocating a CharBuffer for each lookup
+    CharBuffer                  lookup_key;
+
+    // Removes the entries that have expired
+    void purge_expired(std::chrono::steady_clock::time_point now) noexcept;
+
+    // Returns the node's entry, or nullptr if the node has no entry
+    Entry* find_entry(const char* nodename, size_t nodename_length) noexcept;
+
+    void remove_entry(Entry* entry) noexcept;
+
+    static int compare_keys(const CharBuffer* key, const CharBuffer* other);
+};
+
+#endif /* FENCERESULTCACHE_H */
@@ -0,0 +1,177 @@
+#ifndef MPMCQUEUE_H
+#define MPMCQUEUE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <atomic>
+
+// Bounded lock-free multi-producer multi-consumer queue of pointers
+//
+// The queue is a ring of cells, each with a sequence number that tells producers and consumers whether
+// the cell is free for the current round of the ring or contains an element. Producers and consumers
+// claim a position by advancing the enqueue or dequeue position with a compare-and-swap operation,
+// and publish the cell by updating its sequence number, so that neither side ever waits for a lock.
+//
+// The capacity is rounded up to the next power of 2. If the queue is sized for the maximum number of
+// elements that can be queued concurrently, enqueueing never fails.
+template<typename T>
+class MpmcQueue
+{
+  private:
+    class Cell
+    {
+      public:
+        std::atomic<size_t> sequence;
+        T*                  element     = nullptr;
+
+        Cell()
+        {
+            sequence.store(0, std::memory_order_relaxed);
+        }
+
+        virtual ~Cell() noexcept
+        {
+        }
+
+        Cell(const Cell& other) = delete;
+        Cell(Cell&& orig) = delete;
+        virtual Cell& operator=(const Cell& other) = delete;
+        virtual Cell& operator=(Cell&& orig) = delete;
+    };
+
+    // Size of the padding that keeps the positions modified by producers and consumers on different cache lines
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    std::unique_ptr<Cell[]> cell_list_mgr;
+    Cell*                   cell_list       = nullptr;
+    size_t                  capacity        = 0;
+    size_t                  index_mask      = 0;
+
+    char                    enqueue_pad[CACHE_LINE_SIZE];
+    std::atomic<size_t>     enqueue_pos;
+    char                    dequeue_pad[CACHE_LINE_SIZE];
+    std::atomic<size_t>     dequeue_pos;
+    char                    tail_pad[CACHE_LINE_SIZE];
+
+  public:
+    // @throws std::bad_alloc
+    MpmcQueue(const size_t min_capacity)
+    {
+        capacity = 2;
+        while (capacity < min_capacity)
+        {
+            capacity <<= 1;
+        }
+        index_mask = capacity - 1;
+
+        cell_list_mgr = std::unique_ptr<Cell[]>(new Cell[capacity]);
+        cell_list = cell_list_mgr.get();
+        for (size_t idx = 0; idx < capacity; ++idx)
+        {
+            cell_list[idx].sequence.store(idx, std::memory_order_relaxed);
+        }
+
+        enqueue_pos.store(0, std::memory_order_relaxed);
+        dequeue_pos.store(0, std::memory_order_relaxed);
+    }
+
+    virtual ~MpmcQueue() noexcept
+    {
+    }
+
+    MpmcQueue(const MpmcQueue& other) = delete;
+    MpmcQueue(MpmcQueue&& orig) = delete;
+    virtual MpmcQueue& operator=(const MpmcQueue& other) = delete;
+    virtual MpmcQueue& operator=(MpmcQueue&& orig) = delete;
+
+    virtual size_t get_capacity() const noexcept
+    {
+        return capacity;
+    }
+
+    // Returns false if the queue is full
+    virtual bool enqueue(T* const element) noexcept
+    {
+        bool enqueued = false;
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = cell_list[pos & index_mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t> (sequence) - static_cast<intptr_t> (pos);
+            if (diff == 0)
+            {
+                // The cell is free for this round, try to claim the position
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.element = element;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    enqueued = true;
+                    break;
+                }
+                // else: Another producer claimed the position, pos was reloaded by compare_exchange_weak
+            }
+            else
+            if (diff < 0)
+            {
+                // The cell still contains the element of the previous round, the queue is full
+                break;
+            }
+            else
+            {
+                // Another producer claimed the position and published the cell
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        return enqueued;
+    }
+
+    // Returns nullptr if the queue is empty
+    virtual T* dequeue() noexcept
+    {
+        T* element = nullptr;
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Cell& cell = cell_list[pos & index_mask];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const intptr_t diff = static_cast<intptr_t> (sequence) - static_cast<intptr_t> (pos + 1);
+            if (diff == 0)
+            {
+                // The cell contains an element, try to claim the position
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    element = cell.element;
+                    cell.element = nullptr;
+                    // Free the cell for the next round
+                    cell.sequence.store(pos + index_mask + 1, std::memory_order_release);
+                    break;
+                }
+                // else: Another consumer claimed the position, pos was reloaded by compare_exchange_weak
+            }
+            else
+            if (diff < 0)
+            {
+                // The cell has not been published by a producer yet, the queue is empty
+                break;
+            }
+            else
+            {
+                // Another consumer claimed the position and freed the cell
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+        return element;
+    }
+
+    // Returns true if the queue contains elements, or if a producer has claimed a position
+    // but not published the element yet
+    virtual bool has_elements() const noexcept
+    {
+        return enqueue_pos.load(std::memory_order_seq_cst) != dequeue_pos.load(std::memory_order_seq_cst);
+    }
+};
+
+#endif /* MPMCQUEUE_H */
@@ -0,0 +1,104 @@
+#ifndef MPSCQUEUE_H
+#define MPSCQUEUE_H
+
+#include <cstddef>
+#include <atomic>
+
+// Lock-free multi-producer single-consumer queue of intrusively linked objects
+//
+// Producers push objects onto a shared list with a compare-and-swap operation on the list head.
+// The consumer takes the entire shared list with a single exchange operation and reverses it, so that
+// objects are returned in the order they were added. Since the consumer never removes single objects
+// from the shared list, the queue is not affected by the ABA problem.
+//
+// Objects that can be queued must derive from MpscQueue::Node and can only be a member of one
+// MpscQueue at a time.
+template<typename T>
+class MpscQueue
+{
+  public:
+    class Node
+    {
+        friend class MpscQueue;
+
+      private:
+        T* next_mpsc_node = nullptr;
+
+      public:
+        Node()
+        {
+        }
+
+        virtual ~Node() noexcept
+        {
+        }
+
+        Node(const Node& other) = default;
+        Node(Node&& orig) = default;
+        virtual Node& operator=(const Node& other) = default;
+        virtual Node& operator=(Node&& orig) = default;
+    };
+
+  private:
+    // Objects pushed by the producers, most recently pushed object first
+    std::atomic<T*> push_head;
+    // Objects taken by the consumer, in the order they were pushed
+    T*              pop_head    = nullptr;
+
+  public:
+    MpscQueue()
+    {
+        push_head.store(nullptr);
+    }
+
+    virtual ~MpscQueue() noexcept
+    {
+    }
+
+    MpscQueue(const MpscQueue& other) = delete;
+    MpscQueue(MpscQueue&& orig) = delete;
+    virtual MpscQueue& operator=(const MpscQueue& other) = delete;
+    virtual MpscQueue& operator=(MpscQueue&& orig) = delete;
+
+    // May be called by any thread
+    virtual void push(T* const obj) noexcept
+    {
+        Node* const obj_node = static_cast<Node*> (obj);
+        T* head = push_head.load(std::memory_order_relaxed);
+        do
+        {
+            obj_node->next_mpsc_node = head;
+        }
+        while (!push_head.compare_exchange_weak(head, obj, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    // Must only be called by the consumer thread
+    // Returns nullptr if the queue is empty
+    virtual T* pop() noexcept
+    {
+        if (pop_head == nullptr)
+        {
+            // Take the shared list and reverse it
+            T* obj = push_head.exchange(nullptr, std::memory_order_acquire);
+            while (obj != nullptr)
+            {
+                Node* const obj_node = static_cast<Node*> (obj);
+                T* const next_obj = obj_node->next_mpsc_node;
+                obj_node->next_mpsc_node = pop_head;
+                pop_head = obj;
+                obj = next_obj;
+            }
+        }
+
+        T* const obj = pop_head;
+        if (obj != nullptr)
+        {
+            Node* const obj_node = static_cast<Node*> (obj);
+            pop_head = obj_node->next_mpsc_node;
+            obj_node->next_mpsc_node = nullptr;
+        }
+        return obj;
+    }
+};
+
+#endif /* MPSCQUEUE_H */
@@ -1,8 +1,11 @@
 #include "MsgHeader.h"
 
 constexpr size_t MsgHeader::HEADER_SIZE         = 4;
+constexpr size_t MsgHeader::EXT_HEADER_SIZE     = 8;
 constexpr size_t MsgHeader::MSG_TYPE_OFFSET     = 0;
 constexpr size_t MsgHeader::DATA_LENGTH_OFFSET  = 2;
+constexpr size_t MsgHeader::REQUEST_ID_OFFSET   = 4;
+constexpr uint16_t MsgHeader::REQUEST_ID_FLAG   = 0x8000;
 
 MsgHeader::MsgHeader()
 {
@@ -14,8 +17,10 @@ MsgHeader::~MsgHeader() noexcept
 
 void MsgHeader::clear() noexcept
 {
-    msg_type    = 0xFFFF;
-    data_length = 0;
+    msg_type        = 0xFFFF;
+    data_length     = 0;
+    have_request_id = false;
+    request_id      = 0;
 }
 
 bool MsgHeader::is_msg_type(const protocol::MsgType value)
@@ -28,16 +33,41 @@ void MsgHeader::set_msg_type(const protocol::MsgType value)
     msg_type = static_cast<uint16_t> (value);
 }
 
+size_t MsgHeader::get_header_size() const noexcept
+{
+    return have_request_id ? EXT_HEADER_SIZE : HEADER_SIZE;
+}
+
 void MsgHeader::serialize(char* const io_buffer) const
 {
-    field_value_to_bytes(msg_type, io_buffer, MSG_TYPE_OFFSET);
-    field_value_to_bytes(data_length, io_buffer, DATA_LENGTH_OFFSET);
+    if (have_request_id)
+    {
+        field_value_to_bytes(static_cast<uint16_t> (msg_type | REQUEST_ID_FLAG), io_buffer, MSG_TYPE_OFFSET);
+        field_value_to_bytes(data_length, io_buffer, DATA_LENGTH_OFFSET);
+        field_value_to_bytes(static_cast<uint16_t> (request_id >> 16), io_buffer, REQUEST_ID_OFFSET);
+        field_value_to_bytes(static_cast<uint16_t> (request_id & 0xFFFF), io_buffer, REQUEST_ID_OFFSET + 2);
+    }
+    else
+    {
+        field_value_to_bytes(msg_type, io_buffer, MSG_TYPE_OFFSET);
+        field_value_to_bytes(data_length, io_buffer, DATA_LENGTH_OFFSET);
+    }
 }
 
 void MsgHeader::deserialize(const char* const io_buffer)
 {
     msg_type = bytes_to_field_value(io_buffer, MSG_TYPE_OFFSET);
     data_length = bytes_to_field_value(io_buffer, DATA_LENGTH_OFFSET);
+    have_request_id = (msg_type & REQUEST_ID_FLAG) != 0;
+    msg_type = static_cast<uint16_t> (msg_type & ~REQUEST_ID_FLAG);
+    request_id = 0;
+}
+
+void MsgHeader::deserialize_request_id(const char* const io_buffer)
+{
+    request_id = bytes_to_field_value(io_buffer, REQUEST_ID_OFFSET);
+    request_id <<= 16;
+    request_id |= bytes_to_field_value(io_buffer, REQUEST_ID_OFFSET + 2);
 }
 
 uint16_t MsgHeader::bytes_to_field_value(const char* const buffer, const size_t offset) noexcept
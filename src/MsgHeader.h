@@ -6,15 +6,27 @@
 
 #include "Shared.h"
 
+// Message header
+//
+// The basic header consists of the message type and the data length, which is the length of the entire
+// message including the header. If the REQUEST_ID_FLAG bit is set in the message type field, the basic
+// header is followed by a request ID, which the server copies into the reply, so that a client can
+// have multiple requests in progress on the same connection and match the replies, which are sent
+// in completion order, to the requests.
 class MsgHeader
 {
   public:
     static const size_t HEADER_SIZE;
+    static const size_t EXT_HEADER_SIZE;
     static const size_t MSG_TYPE_OFFSET;
     static const size_t DATA_LENGTH_OFFSET;
+    static const size_t REQUEST_ID_OFFSET;
+    static const uint16_t REQUEST_ID_FLAG;
 
-    uint16_t        msg_type    = 0xFFFF;
-    uint16_t        data_length = 0;
+    uint16_t        msg_type        = 0xFFFF;
+    uint16_t        data_length     = 0;
+    bool            have_request_id = false;
+    uint32_t        request_id      = 0;
 
     MsgHeader();
     virtual ~MsgHeader() noexcept;
@@ -26,9 +38,20 @@ class MsgHeader
 
     virtual bool is_msg_type(const protocol::MsgType value);
     virtual void set_msg_type(const protocol::MsgType value);
+
+    // Returns the size of the header, including the request ID, if present
+    virtual size_t get_header_size() const noexcept;
+
+    // Serializes the header, including the request ID, if present
     virtual void serialize(char* io_buffer) const;
+
+    // Deserializes the basic header
+    // If have_request_id is set afterwards, the request ID must be deserialized by calling
+    // deserialize_request_id once EXT_HEADER_SIZE bytes are available
     virtual void deserialize(const char* io_buffer);
 
+    virtual void deserialize_request_id(const char* io_buffer);
+
     static uint16_t bytes_to_field_value(const char* buffer, size_t offset) noexcept;
     static void field_value_to_bytes(uint16_t value, char* buffer, size_t offset) noexcept;
 };
@@ -0,0 +1,98 @@
+#include "RingBuffer.h"
+#include "zero_memory.h"
+
+extern "C"
+{
+    #include <errno.h>
+    #include <sys/socket.h>
+    #include <sys/uio.h>
+}
+
+// @throws std::bad_alloc
+RingBuffer::RingBuffer(const size_t capacity_value):
+    capacity(capacity_value),
+    index_mask(capacity_value - 1)
+{
+    data_mgr = std::unique_ptr<char[]>(new char[capacity]);
+    data = data_mgr.get();
+    zero_memory(data, capacity);
+}
+
+RingBuffer::~RingBuffer() noexcept
+{
+    zero_memory(data, capacity);
+}
+
+ssize_t RingBuffer::receive(const int socket_fd, const int flags) noexcept
+{
+    const size_t free_length = capacity - data_length;
+    if (free_length == 0)
+    {
+        errno = ENOBUFS;
+        return -1;
+    }
+
+    // The free space is either a single segment, or wraps around the end of the buffer
+    const size_t free_start = (data_start + data_length) & index_mask;
+    const size_t first_length = free_start + free_length <= capacity ? free_length : capacity - free_start;
+
+    struct iovec io_vector[2];
+    io_vector[0].iov_base = &(data[free_start]);
+    io_vector[0].iov_len = first_length;
+    io_vector[1].iov_base = data;
+    io_vector[1].iov_len = free_length - first_length;
+
+    struct msghdr message;
+    zero_memory(reinterpret_cast<char*> (&message), sizeof (message));
+    message.msg_iov = io_vector;
+    message.msg_iovlen = first_length < free_length ? 2 : 1;
+
+    const ssize_t read_size = recvmsg(socket_fd, &message, flags);
+    if (read_size > 0)
+    {
+        data_length += static_cast<size_t> (read_size);
+    }
+    return read_size;
+}
+
+size_t RingBuffer::get_length() const noexcept
+{
+    return data_length;
+}
+
+size_t RingBuffer::get_free() const noexcept
+{
+    return capacity - data_length;
+}
+
+void RingBuffer::peek(char* const dst, const size_t length) const noexcept
+{
+    for (size_t idx = 0; idx < length; ++idx)
+    {
+        dst[idx] = data[(data_start + idx) & index_mask];
+    }
+}
+
+void RingBuffer::read(char* const dst, const size_t length) noexcept
+{
+    for (size_t idx = 0; idx < length; ++idx)
+    {
+        const size_t data_idx = (data_start + idx) & index_mask;
+        dst[idx] = data[data_idx];
+        data[data_idx] = 0;
+    }
+    data_start = (data_start + length) & index_mask;
+    data_length -= length;
+    if (data_length == 0)
+    {
+        // Restart at the beginning of the buffer, so that the next receive needs only a single segment
+        data_start = 0;
+    }
+}
+
+void RingBuffer::clear() noexcept
+{
+    zero_memory(data, capacity);
+    data_start = 0;
+    data_length = 0;
+}
@@ -0,0 +1,60 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <cstddef>
+#include <memory>
+
+extern "C"
+{
+    #include <sys/types.h>
+}
+
+// Receive buffer for a stream socket
+//
+// Receives as much data as the kernel has available, up to the free space of the buffer, with a single
+// system call, even if the free space wraps around the end of the buffer. The data is consumed in the
+// order it was received, so that multiple messages received at once, as well as partially received
+// messages, can be extracted from the buffer. Consumed data is wiped from the buffer.
+class RingBuffer
+{
+  public:
+    // The capacity must be a power of 2
+    // @throws std::bad_alloc
+    RingBuffer(size_t capacity);
+    virtual ~RingBuffer() noexcept;
+    RingBuffer(const RingBuffer& other) = delete;
+    RingBuffer(RingBuffer&& orig) = delete;
+    virtual RingBuffer& operator=(const RingBuffer& other) = delete;
+    virtual RingBuffer& operator=(RingBuffer&& orig) = delete;
+
+    // Receives data into the free space of the buffer
+    // Returns the result of the recvmsg() system call; if the buffer is full, returns -1 and sets errno
+    // to ENOBUFS without receiving any data
+    virtual ssize_t receive(int socket_fd, int flags) noexcept;
+
+    virtual size_t get_length() const noexcept;
+    virtual size_t get_free() const noexcept;
+
+    // Copies data from the start of the buffer without consuming it
+    // The length must not exceed the length of the data in the buffer
+    virtual void peek(char* dst, size_t length) const noexcept;
+
+    // Copies and consumes data from the start of the buffer
+    // The length must not exceed the length of the data in the buffer
+    virtual void read(char* dst, size_t length) noexcept;
+
+    // Discards and wipes all data
+    virtual void clear() noexcept;
+
+  private:
+    std::unique_ptr<char[]> data_mgr;
+
+    char*   data            = nullptr;
+    size_t  capacity        = 0;
+    size_t  index_mask      = 0;
+    // Index of the first byte of the data
+    size_t  data_start      = 0;
+    size_t  data_length     = 0;
+};
+
+#endif /* RINGBUFFER_H */
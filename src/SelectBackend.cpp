@@ -0,0 +1,149 @@
+#include "SelectBackend.h"
+#include "exceptions.h"
+
+extern "C"
+{
+    #include <errno.h>
+    #include <sys/time.h>
+}
+
+// @throws std::bad_alloc
+SelectBackend::SelectBackend()
+{
+    registry_mgr = std::unique_ptr<Registration[]>(new Registration[FD_SETSIZE]);
+    registry = registry_mgr.get();
+    snapshot_mgr = std::unique_ptr<Target*[]>(new Target*[FD_SETSIZE]);
+    snapshot = snapshot_mgr.get();
+
+    read_fd_set_mgr = std::unique_ptr<fd_set>(new fd_set);
+    write_fd_set_mgr = std::unique_ptr<fd_set>(new fd_set);
+    read_fd_set = read_fd_set_mgr.get();
+    write_fd_set = write_fd_set_mgr.get();
+}
+
+SelectBackend::~SelectBackend() noexcept
+{
+}
+
+void SelectBackend::init()
+{
+    std::unique_lock<std::mutex> lock(registry_lock);
+    for (size_t idx = 0; idx < FD_SETSIZE; ++idx)
+    {
+        registry[idx].target = nullptr;
+        registry[idx].interest = Interest::NONE;
+        snapshot[idx] = nullptr;
+    }
+    max_fd = -1;
+}
+
+// @throws OsException
+void SelectBackend::register_fd(const int fd, const Interest interest, Target* const target)
+{
+    check_fd(fd);
+
+    std::unique_lock<std::mutex> lock(registry_lock);
+    registry[fd].target = target;
+    registry[fd].interest = interest;
+    if (fd > max_fd)
+    {
+        max_fd = fd;
+    }
+}
+
+// @throws OsException
+void SelectBackend::modify_fd(const int fd, const Interest interest, Target* const target)
+{
+    register_fd(fd, interest, target);
+}
+
+void SelectBackend::unregister_fd(const int fd) noexcept
+{
+    if (fd >= 0 && fd < FD_SETSIZE)
+    {
+        std::unique_lock<std::mutex> lock(registry_lock);
+        registry[fd].target = nullptr;
+        registry[fd].interest = Interest::NONE;
+        while (max_fd >= 0 && registry[max_fd].target == nullptr)
+        {
+            --max_fd;
+        }
+    }
+}
+
+// @throws OsException
+size_t SelectBackend::wait(Event* const events, const size_t events_capacity, const int timeout)
+{
+    FD_ZERO(read_fd_set);
+    FD_ZERO(write_fd_set);
+
+    // Rebuild the fd sets from the registrations. Targets are recorded in the snapshot, because
+    // registrations may be changed by other threads while the selector is waiting.
+    int nfds = 0;
+    {
+        std::unique_lock<std::mutex> lock(registry_lock);
+        for (int fd = 0; fd <= max_fd; ++fd)
+        {
+            snapshot[fd] = registry[fd].target;
+            const Interest fd_interest = registry[fd].interest;
+            if (fd_interest == Interest::READ || fd_interest == Interest::READ_WRITE)
+            {
+                FD_SET(fd, read_fd_set);
+                nfds = fd + 1;
+            }
+            if (fd_interest == Interest::WRITE || fd_interest == Interest::READ_WRITE)
+            {
+                FD_SET(fd, write_fd_set);
+                nfds = fd + 1;
+            }
+        }
+    }
+
+    struct timeval timeout_value;
+    struct timeval* timeout_ptr = nullptr;
+    if (timeout != TIMEOUT_INFINITE)
+    {
+        timeout_value.tv_sec = timeout / 1000;
+        timeout_value.tv_usec = (timeout % 1000) * 1000;
+        timeout_ptr = &timeout_value;
+    }
+
+    size_t event_count = 0;
+    int select_rc = select(nfds, read_fd_set, write_fd_set, nullptr, timeout_ptr);
+    if (select_rc > 0)
+    {
+        for (int fd = 0; fd < nfds && event_count < events_capacity; ++fd)
+        {
+            const bool readable = FD_ISSET(fd, read_fd_set) != 0;
+            const bool writable = FD_ISSET(fd, write_fd_set) != 0;
+            if ((readable || writable) && snapshot[fd] != nullptr)
+            {
+                Event& ready_event = events[event_count];
+                ready_event.target = snapshot[fd];
+                ready_event.readable = readable;
+                ready_event.writable = writable;
+                ++event_count;
+            }
+        }
+    }
+    else
+    if (select_rc == -1 && errno != EINTR)
+    {
+        throw OsException(OsException::ErrorId::IO_ERROR);
+    }
+    return event_count;
+}
+
+const char* SelectBackend::get_name() const noexcept
+{
+    return "select";
+}
+
+// @throws OsException
+void SelectBackend::check_fd(const int fd)
+{
+    if (fd < 0 || fd >= FD_SETSIZE)
+    {
+        throw OsException(OsException::ErrorId::INVALID_SELECT_FD);
+    }
+}
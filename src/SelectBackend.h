@@ -0,0 +1,68 @@
+#ifndef SELECTBACKEND_H
+#define SELECTBACKEND_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+
+#include "SelectorBackend.h"
+
+extern "C"
+{
+    #include <sys/select.h>
+}
+
+// Portable selector backend based on select(...)
+// Limited to file descriptors below FD_SETSIZE; the fd sets are rebuilt from the
+// registrations on every wait
+class SelectBackend : public SelectorBackend
+{
+  private:
+    struct Registration
+    {
+        Target*     target      = nullptr;
+        Interest    interest    = Interest::NONE;
+    };
+
+    std::mutex                          registry_lock;
+    std::unique_ptr<Registration[]>     registry_mgr;
+    Registration*                       registry        = nullptr;
+    std::unique_ptr<Target*[]>          snapshot_mgr;
+    Target**                            snapshot        = nullptr;
+    int                                 max_fd          = -1;
+
+    std::unique_ptr<fd_set>             read_fd_set_mgr;
+    std::unique_ptr<fd_set>             write_fd_set_mgr;
+    fd_set*                             read_fd_set     = nullptr;
+    fd_set*                             write_fd_set    = nullptr;
+
+  public:
+    // @throws std::bad_alloc
+    SelectBackend();
+    virtual ~SelectBackend() noexcept;
+    SelectBackend(const SelectBackend& other) = delete;
+    SelectBackend(SelectBackend&& orig) = delete;
+    virtual SelectBackend& operator=(const SelectBackend& other) = delete;
+    virtual SelectBackend& operator=(SelectBackend&& orig) = delete;
+
+    virtual void init() override;
+
+    // @throws OsException
+    virtual void register_fd(int fd, Interest interest, Target* target) override;
+
+    // @throws OsException
+    virtual void modify_fd(int fd, Interest interest, Target* target) override;
+
+    virtual void unregister_fd(int fd) noexcept override;
+
+    // @throws OsException
+    virtual size_t wait(Event* events, size_t events_capacity, int timeout) override;
+
+    virtual const char* get_name() const noexcept override;
+
+  private:
+    // @throws OsException
+    static void check_fd(int fd);
+};
+
+#endif /* SELECTBACKEND_H */
@@ -0,0 +1,40 @@
+#include "SelectorBackend.h"
+#include "SelectBackend.h"
+#include "EpollBackend.h"
+
+const int SelectorBackend::TIMEOUT_INFINITE = -1;
+
+SelectorBackend::SelectorBackend()
+{
+}
+
+SelectorBackend::~SelectorBackend() noexcept
+{
+}
+
+// @throws std::bad_alloc
+SelectorBackend* SelectorBackend::create(const Type backend_type)
+{
+    SelectorBackend* backend = nullptr;
+    switch (backend_type)
+    {
+        case Type::SELECT:
+            backend = new SelectBackend();
+            break;
+        case Type::EPOLL:
+            // fall-through
+        default:
+            backend = new EpollBackend();
+            break;
+    }
+    return backend;
+}
+
+SelectorBackend::Target::Target(const Kind kind)
+{
+    target_kind = kind;
+}
+
+SelectorBackend::Target::~Target() noexcept
+{
+}
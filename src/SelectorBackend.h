@@ -0,0 +1,90 @@
+#ifndef SELECTORBACKEND_H
+#define SELECTORBACKEND_H
+
+#include <cstddef>
+#include <cstdint>
+
+class SelectorBackend
+{
+  public:
+    enum class Type : uint8_t
+    {
+        SELECT  = 0,
+        EPOLL   = 1
+    };
+
+    enum class Interest : uint8_t
+    {
+        NONE        = 0,
+        READ        = 1,
+        WRITE       = 2,
+        READ_WRITE  = 3
+    };
+
+    // Base class of all objects that are registered with a selector backend
+    // The target of a ready event is identified by its kind
+    class Target
+    {
+      public:
+        enum class Kind : uint8_t
+        {
+            LISTENER    = 0,
+            WAKEUP      = 1,
+            CLIENT      = 2
+        };
+
+        Kind target_kind;
+
+        Target(Kind kind);
+        virtual ~Target() noexcept;
+        Target(const Target& other) = default;
+        Target(Target&& orig) = default;
+        virtual Target& operator=(const Target& other) = default;
+        virtual Target& operator=(Target&& orig) = default;
+    };
+
+    struct Event
+    {
+        Target* target      = nullptr;
+        bool    readable    = false;
+        bool    writable    = false;
+    };
+
+    static const int TIMEOUT_INFINITE;
+
+    SelectorBackend();
+    virtual ~SelectorBackend() noexcept;
+    SelectorBackend(const SelectorBackend& other) = delete;
+    SelectorBackend(SelectorBackend&& orig) = delete;
+    virtual SelectorBackend& operator=(const SelectorBackend& other) = delete;
+    virtual SelectorBackend& operator=(SelectorBackend&& orig) = delete;
+
+    // @throws OsException
+    virtual void init() = 0;
+
+    // Registers a file descriptor with the specified interest
+    // @throws OsException
+    virtual void register_fd(int fd, Interest interest, Target* target) = 0;
+
+    // Changes the interest of an already registered file descriptor
+    // May be called concurrently with wait() by other threads
+    // @throws OsException
+    virtual void modify_fd(int fd, Interest interest, Target* target) = 0;
+
+    // Must be called before the file descriptor is closed
+    virtual void unregister_fd(int fd) noexcept = 0;
+
+    // Waits for registered file descriptors to become ready and stores up to events_capacity
+    // ready events in the events array
+    // The timeout is specified in milliseconds, or TIMEOUT_INFINITE
+    // Returns the number of events stored in the events array; an interrupted wait returns 0
+    // @throws OsException
+    virtual size_t wait(Event* events, size_t events_capacity, int timeout) = 0;
+
+    virtual const char* get_name() const noexcept = 0;
+
+    // @throws std::bad_alloc
+    static SelectorBackend* create(Type backend_type);
+};
+
+#endif /* SELECTORBACKEND_H */
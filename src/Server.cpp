@@ -8,6 +8,7 @@
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <algorithm>
 
 #include <CharBuffer.h>
 
@@ -43,35 +44,152 @@ int Server::run(const int argc, const char* const argv[]) noexcept
             std::setw(8) << std::setfill('0') << ufh::VERSION_CODE << "\n\n" << std::flush;
 
         std::unique_ptr<PluginMgr> plugin;
-        std::unique_ptr<ServerConnector> connector;
+        std::unique_ptr<Shard[]> shard_list_mgr;
+        Shard* shard_list = nullptr;
+        size_t shard_count = 0;
+        size_t min_workers = 0;
+        size_t max_workers = 0;
+        size_t worker_idle_timeout = 0;
         {
             std::unique_ptr<ServerParameters> params(new ServerParameters());
             params->initialize();
             params->read_parameters(argc, argv);
-            params->check_required();
 
+            // The server listens on the endpoint selected by the protocol, bind_address and tcp_port parameters,
+            // on the endpoints of the endpoints parameter, or on both
+            // If the protocol is UNIX, the bind_address is the path of the server's unix domain socket
             const CharBuffer& protocol = params->get_value(ServerParameters::KEY_PROTOCOL);
-            const CharBuffer& bind_address = params->get_value(ServerParameters::KEY_BIND_ADDRESS);
-            const CharBuffer& port = params->get_value(ServerParameters::KEY_TCP_PORT);
+            const bool have_endpoints = params->get_value(ServerParameters::KEY_ENDPOINTS).length() > 0;
+            if (protocol.length() > 0 || !have_endpoints)
+            {
+                params->mark_required(ServerParameters::KEY_PROTOCOL);
+                params->mark_required(ServerParameters::KEY_BIND_ADDRESS);
+                if (!(protocol == keyword::PROTO_UNIX))
+                {
+                    params->mark_required(ServerParameters::KEY_TCP_PORT);
+                }
+            }
+            params->check_required();
+
             const CharBuffer& fence_module = params->get_value(ServerParameters::KEY_FENCE_MODULE);
+            const SelectorBackend::Type selector_type = params->get_selector_type();
+            shard_count = params->get_shard_count();
+            const uid_t peer_uid = params->get_peer_uid();
+            size_t endpoint_count = 0;
+            std::unique_ptr<Endpoint[]> endpoint_list_mgr = params->get_endpoint_list(endpoint_count);
+            const Endpoint* const endpoint_list = endpoint_list_mgr.get();
+
+            // Only one socket can be bound to the path of a unix domain socket, therefore unix domain sockets
+            // are served by the first shard only, and there is no use for further shards if the server
+            // listens on unix domain sockets only
+            bool have_ip_endpoints = false;
+            for (size_t idx = 0; idx < endpoint_count; ++idx)
+            {
+                have_ip_endpoints = have_ip_endpoints || !endpoint_list[idx].is_unix_socket();
+            }
+            if (!have_ip_endpoints && shard_count > 1)
+            {
+                std::cout << ufh::LOGPFX_START << "Listening on unix domain sockets only, "
+                    "limiting the number of reactor shards to 1" << std::endl;
+                shard_count = 1;
+            }
+            const size_t max_connections = params->get_max_connections(shard_count);
+            const size_t connection_backlog = params->get_connection_backlog();
+            const size_t idle_timeout = params->get_idle_timeout();
+            const size_t recv_timeout = params->get_recv_timeout();
+            const size_t send_timeout = params->get_send_timeout();
+            max_workers = params->get_max_workers(shard_count);
+            min_workers = std::min(params->get_min_workers(shard_count), max_workers);
+            worker_idle_timeout = params->get_worker_idle_timeout();
+            const size_t fence_cache_ttl = params->get_fence_cache_ttl();
+            params->get_socket_tuning(socket_tuning);
+            std::cout << ufh::LOGPFX_START << "TCP socket options: nodelay = " << std::dec << socket_tuning.nodelay <<
+                ", quickack = " << socket_tuning.quickack << ", defer_accept = " << socket_tuning.defer_accept <<
+                ", fastopen = " << socket_tuning.fastopen << ", rcvbuf = " << socket_tuning.recv_buffer_size <<
+                ", sndbuf = " << socket_tuning.send_buffer_size << ", keepidle = " << socket_tuning.keepalive_idle <<
+                ", keepintvl = " << socket_tuning.keepalive_interval << ", keepcnt = " <<
+                socket_tuning.keepalive_count << ", user_timeout = " << socket_tuning.user_timeout << std::endl;
+
+            if (fence_cache_ttl > 0)
+            {
+                std::cout << ufh::LOGPFX_START << "Caching the results of successful fencing actions for " <<
+                    std::dec << fence_cache_ttl << " second(s)" << std::endl;
+                flight_table.enable_result_cache(std::chrono::seconds(fence_cache_ttl));
+            }
 
             plugin = std::unique_ptr<PluginMgr>(new PluginMgr(fence_module.c_str(), this));
-            connector = std::unique_ptr<ServerConnector>(
-                new ServerConnector(*this, *stop_signal, protocol, bind_address, port)
+
+            std::cout << ufh::LOGPFX_START << "Initializing " << std::dec << shard_count <<
+                " reactor shard(s)" << std::endl;
+            shard_list_mgr = std::unique_ptr<Shard[]>(new Shard[shard_count]);
+            shard_list = shard_list_mgr.get();
+            for (size_t idx = 0; idx < shard_count; ++idx)
+            {
+                shard_list[idx].connector = std::unique_ptr<ServerConnector>(
+                    new ServerConnector(
+                        *this, *stop_signal, endpoint_list, endpoint_count, idx == 0, peer_uid,
+                        selector_type, shard_count > 1,
+                        max_connections, connection_backlog, idle_timeout, recv_timeout, send_timeout
+                    )
+                );
+            }
+        }
+
+        for (size_t idx = 0; idx < shard_count; ++idx)
+        {
+            ServerConnector* const connector = shard_list[idx].connector.get();
+            shard_list[idx].thread_pool = std::unique_ptr<WorkerPool>(
+                new WorkerPool(
+                    min_workers,
+                    max_workers,
+                    std::chrono::seconds(worker_idle_timeout),
+                    connector->get_max_pending_requests(),
+                    connector->get_worker_thread_invocation()
+                )
             );
+            shard_list[idx].thread_pool->start();
         }
 
-        std::unique_ptr<WorkerPool> thread_pool(
-            new WorkerPool(
-                &(connector->action_queue_lock),
-                ServerConnector::MAX_CONNECTIONS,
-                connector->get_worker_thread_invocation()
-            )
-        );
+        // The listeners of all shards are bound with SO_REUSEPORT, which must not bind the server to an
+        // address and port that another process is already listening on
+        if (shard_count > 1)
+        {
+            shard_list[0].connector->check_listener_addresses();
+        }
 
-        thread_pool->start();
+        // Shard 0 runs on the current thread, all other shards run on a thread of their own
+        try
+        {
+            for (size_t idx = 1; idx < shard_count; ++idx)
+            {
+                shard_list[idx].shard_thread = std::thread(&Shard::run, &(shard_list[idx]));
+            }
+        }
+        catch (std::system_error&)
+        {
+            // Stop the shards that have already been started
+            stop_signal->signal();
+            throw;
+        }
+        shard_list[0].run();
+
+        // The shard that stopped first has signaled all other shards to stop
+        for (size_t idx = 1; idx < shard_count; ++idx)
+        {
+            if (shard_list[idx].shard_thread.joinable())
+            {
+                shard_list[idx].shard_thread.join();
+            }
+        }
+
+        for (size_t idx = 0; idx < shard_count; ++idx)
+        {
+            if (shard_list[idx].shard_exc)
+            {
+                std::rethrow_exception(shard_list[idx].shard_exc);
+            }
+        }
 
-        connector->run(*thread_pool);
         // Newline after possible "^C" output caused by Ctrl-C being entered on the console, purely cosmetic
         std::cout << std::endl;
 
@@ -111,28 +229,162 @@ int Server::run(const int argc, const char* const argv[]) noexcept
 
 bool Server::fence_action_off(const CharBuffer& nodename, const CharBuffer& client_secret) noexcept
 {
-    report_fence_action(LABEL_OFF, nodename);
-    bool success_flag = plugin_functions.ufh_fence_off(plugin_context, nodename.c_str(), nodename.length());
-    report_fence_action_result(LABEL_OFF, nodename, success_flag);
-    return success_flag;
+    return fence_action_impl(LABEL_OFF, plugin_functions.ufh_fence_off, nodename);
 }
 
 bool Server::fence_action_on(const CharBuffer& nodename, const CharBuffer& client_secret) noexcept
 {
-    report_fence_action(LABEL_ON, nodename);
-    bool success_flag = plugin_functions.ufh_fence_on(plugin_context, nodename.c_str(), nodename.length());
-    report_fence_action_result(LABEL_ON, nodename, success_flag);
-    return success_flag;
+    return fence_action_impl(LABEL_ON, plugin_functions.ufh_fence_on, nodename);
 }
 
 bool Server::fence_action_reboot(const CharBuffer& nodename, const CharBuffer& client_secret) noexcept
 {
-    report_fence_action(LABEL_REBOOT, nodename);
-    bool success_flag = plugin_functions.ufh_fence_reboot(plugin_context, nodename.c_str(), nodename.length());
-    report_fence_action_result(LABEL_REBOOT, nodename, success_flag);
+    return fence_action_impl(LABEL_REBOOT, plugin_functions.ufh_fence_reboot, nodename);
+}
+
+bool Server::fence_batch_off(
+    const char* const* const nodename_list,
+    const size_t* const nodename_length_list,
+    const size_t node_count,
+    bool* const result_list,
+    const CharBuffer& client_secret
+) noexcept
+{
+    return fence_batch_impl(
+        LABEL_OFF, plugin_functions.ufh_fence_off_batch,
+        nodename_list, nodename_length_list, node_count, result_list
+    );
+}
+
+bool Server::fence_batch_on(
+    const char* const* const nodename_list,
+    const size_t* const nodename_length_list,
+    const size_t node_count,
+    bool* const result_list,
+    const CharBuffer& client_secret
+) noexcept
+{
+    return fence_batch_impl(
+        LABEL_ON, plugin_functions.ufh_fence_on_batch,
+        nodename_list, nodename_length_list, node_count, result_list
+    );
+}
+
+bool Server::fence_batch_reboot(
+    const char* const* const nodename_list,
+    const size_t* const nodename_length_list,
+    const size_t node_count,
+    bool* const result_list,
+    const CharBuffer& client_secret
+) noexcept
+{
+    return fence_batch_impl(
+        LABEL_REBOOT, plugin_functions.ufh_fence_reboot_batch,
+        nodename_list, nodename_length_list, node_count, result_list
+    );
+}
+
+bool Server::fence_action_impl(
+    const char* const action,
+    const plugin::fence_call fence_call,
+    const CharBuffer& nodename
+) noexcept
+{
+    bool success_flag = false;
+    FenceFlightTable::Flight own_flight;
+    FenceFlightTable::Flight* const flight = flight_table.enter(
+        &own_flight, nodename.c_str(), nodename.length(), action
+    );
+    if (flight == nullptr)
+    {
+        ++(stats.fence_cache_hits);
+        report_fence_action_cached(action, nodename.c_str());
+        success_flag = true;
+    }
+    else
+    if (flight == &own_flight)
+    {
+        if (flight_table.have_result_cache())
+        {
+            ++(stats.fence_cache_misses);
+        }
+        if (flight_table.await_turn(flight))
+        {
+            ++(stats.fence_serialized);
+        }
+        report_fence_action(action, nodename.c_str());
+        success_flag = fence_call(plugin_context, nodename.c_str(), nodename.length());
+        report_fence_action_result(action, nodename.c_str(), success_flag);
+        flight_table.complete(flight, success_flag);
+    }
+    else
+    {
+        ++(stats.fence_coalesced);
+        report_fence_action_coalesced(action, nodename.c_str());
+        success_flag = flight_table.await_result(flight);
+    }
     return success_flag;
 }
 
+bool Server::fence_batch_impl(
+    const char* const action,
+    const plugin::fence_batch_call batch_call,
+    const char* const* const nodename_list,
+    const size_t* const nodename_length_list,
+    const size_t node_count,
+    bool* const result_list
+) noexcept
+{
+    const bool have_batch_call = batch_call != nullptr;
+    if (have_batch_call)
+    {
+        // Fencing actions that are part of a batch are serialized with other fencing actions affecting
+        // the same nodes, but are not coalesced with them, since the plugin call fences all nodes anyway
+        std::unique_ptr<FenceFlightTable::Flight[]> flight_list_mgr;
+        try
+        {
+            flight_list_mgr = std::unique_ptr<FenceFlightTable::Flight[]>(new FenceFlightTable::Flight[node_count]);
+        }
+        catch (std::bad_alloc&)
+        {
+            std::cerr << ufh::LOGPFX_WARNING << "Cannot serialize batch fencing action \"" << action <<
+                "\" with other fencing actions: Out of memory" << std::endl;
+        }
+        FenceFlightTable::Flight* const flight_list = flight_list_mgr.get();
+
+        if (flight_list != nullptr)
+        {
+            flight_table.enter_group(flight_list, nodename_list, nodename_length_list, node_count, action);
+            bool waited = false;
+            for (size_t idx = 0; idx < node_count; ++idx)
+            {
+                waited = flight_table.await_turn(&(flight_list[idx])) || waited;
+            }
+            if (waited)
+            {
+                ++(stats.fence_serialized);
+            }
+        }
+        for (size_t idx = 0; idx < node_count; ++idx)
+        {
+            report_fence_action(action, nodename_list[idx]);
+        }
+        batch_call(plugin_context, nodename_list, nodename_length_list, node_count, result_list);
+        for (size_t idx = 0; idx < node_count; ++idx)
+        {
+            report_fence_action_result(action, nodename_list[idx], result_list[idx]);
+        }
+        if (flight_list != nullptr)
+        {
+            for (size_t idx = 0; idx < node_count; ++idx)
+            {
+                flight_table.complete(&(flight_list[idx]), result_list[idx]);
+            }
+        }
+    }
+    return have_batch_call;
+}
+
 const char* Server::get_version() noexcept
 {
     return ufh::VERSION_STRING;
@@ -143,20 +395,78 @@ uint32_t Server::get_version_code() noexcept
     return ufh::VERSION_CODE;
 }
 
-void Server::report_fence_action(const char* const action, const CharBuffer& nodename)
+ServerStats& Server::get_stats() noexcept
+{
+    return stats;
+}
+
+socket_setup::Tuning& Server::get_socket_tuning() noexcept
+{
+    return socket_tuning;
+}
+
+void Server::report_fence_action(const char* const action, const char* const nodename)
 {
     std::unique_lock<std::mutex> scope_lock(stdio_lock);
     std::cout << ufh::LOGPFX_FENCE << "Executing fencing action \"" << action <<
-        "\" affecting node \"" << nodename.c_str() << "\"" << std::endl;
+        "\" affecting node \"" << nodename << "\"" << std::endl;
 }
 
-void Server::report_fence_action_result(const char* const action, const CharBuffer& nodename, const bool success_flag)
+void Server::report_fence_action_result(
+    const char* const action,
+    const char* const nodename,
+    const bool success_flag
+)
 {
     std::unique_lock<std::mutex> scope_lock(stdio_lock);
     std::cout << ufh::LOGPFX_FENCE << "Fencing action \"" << action <<
-        "\" affecting node \"" << nodename.c_str() << "\" " << (success_flag ? "SUCCEEDED" : "FAILED") << std::endl;
+        "\" affecting node \"" << nodename << "\" " << (success_flag ? "SUCCEEDED" : "FAILED") << std::endl;
+}
+
+void Server::report_fence_action_coalesced(const char* const action, const char* const nodename)
+{
+    std::unique_lock<std::mutex> scope_lock(stdio_lock);
+    std::cout << ufh::LOGPFX_FENCE << "Fencing action \"" << action << "\" affecting node \"" << nodename <<
+        "\" is coalesced with an identical pending fencing action" << std::endl;
 }
 
+void Server::report_fence_action_cached(const char* const action, const char* const nodename)
+{
+    std::unique_lock<std::mutex> scope_lock(stdio_lock);
+    std::cout << ufh::LOGPFX_FENCE << "Fencing action \"" << action << "\" affecting node \"" << nodename <<
+        "\" SUCCEEDED recently, returning the cached result" << std::endl;
+}
+
+Server::Shard::Shard()
+{
+}
+
+Server::Shard::~Shard() noexcept
+{
+    if (shard_thread.joinable())
+    {
+        try
+        {
+            shard_thread.join();
+        }
+        catch (std::system_error& ignored)
+        {
+        }
+    }
+}
+
+void Server::Shard::run() noexcept
+{
+    try
+    {
+        connector->run(*thread_pool);
+    }
+    catch (...)
+    {
+        // The connector's cleanup signals all other shards to stop
+        shard_exc = std::current_exception();
+    }
+}
 
 // @throws OsException, PluginException
 Server::PluginMgr::PluginMgr(const char* path, Server* srv_ref)
@@ -2,16 +2,32 @@
 #define SERVER_H
 
 #include <cstddef>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <exception>
 #include <CharBuffer.h>
 
 #include "SignalHandler.h"
 #include "plugin_loader.h"
+#include "ServerStats.h"
+#include "FenceFlightTable.h"
+#include "socket_setup.h"
+
+class ServerConnector;
+class WorkerPool;
 
 class Server
 {
   public:
     typedef bool (Server::*fence_action_method)(const CharBuffer& nodename, const CharBuffer& client_secret);
+    typedef bool (Server::*fence_batch_method)(
+        const char* const* nodename_list,
+        const size_t* nodename_length_list,
+        size_t node_count,
+        bool* result_list,
+        const CharBuffer& client_secret
+    );
 
     static const char* const LABEL_OFF;
     static const char* const LABEL_ON;
@@ -30,8 +46,36 @@ class Server
     virtual bool fence_action_off(const CharBuffer& nodename, const CharBuffer& client_secret) noexcept;
     virtual bool fence_action_on(const CharBuffer& nodename, const CharBuffer& client_secret) noexcept;
     virtual bool fence_action_reboot(const CharBuffer& nodename, const CharBuffer& client_secret) noexcept;
+
+    // Batch fencing actions execute the fencing action for all nodes by a single call of the plugin's
+    // batch entry point and store the result for each node in the corresponding element of result_list
+    // Returns false without executing any fencing actions if the plugin does not provide a batch entry point
+    virtual bool fence_batch_off(
+        const char* const* nodename_list,
+        const size_t* nodename_length_list,
+        size_t node_count,
+        bool* result_list,
+        const CharBuffer& client_secret
+    ) noexcept;
+    virtual bool fence_batch_on(
+        const char* const* nodename_list,
+        const size_t* nodename_length_list,
+        size_t node_count,
+        bool* result_list,
+        const CharBuffer& client_secret
+    ) noexcept;
+    virtual bool fence_batch_reboot(
+        const char* const* nodename_list,
+        const size_t* nodename_length_list,
+        size_t node_count,
+        bool* result_list,
+        const CharBuffer& client_secret
+    ) noexcept;
     virtual const char* get_version() noexcept;
     virtual uint32_t get_version_code() noexcept;
+    virtual ServerStats& get_stats() noexcept;
+    // Socket options of TCP sockets, shared by all reactor shards
+    virtual socket_setup::Tuning& get_socket_tuning() noexcept;
 
   private:
     class PluginMgr
@@ -51,13 +95,54 @@ class Server
         virtual PluginMgr& operator=(PluginMgr&& orig) = default;
     };
 
+    // Reactor shard, consisting of a network connector with its own server socket, selector,
+    // client pool and queues, and the worker pool that executes the connector's requests
+    class Shard
+    {
+      public:
+        // The thread_pool must be destroyed before the connector
+        std::unique_ptr<ServerConnector>    connector;
+        std::unique_ptr<WorkerPool>         thread_pool;
+        std::thread                         shard_thread;
+        std::exception_ptr                  shard_exc;
+
+        Shard();
+        virtual ~Shard() noexcept;
+        Shard(const Shard& other) = delete;
+        Shard(Shard&& orig) = delete;
+        virtual Shard& operator=(const Shard& other) = delete;
+        virtual Shard& operator=(Shard&& orig) = delete;
+
+        // Runs the connector's selector loop, any exception is stored in shard_exc
+        virtual void run() noexcept;
+    };
+
     SignalHandler* stop_signal;
 
+    ServerStats stats;
+    socket_setup::Tuning socket_tuning;
+
     plugin::function_table plugin_functions;
     void* plugin_context;
 
-    void report_fence_action(const char* action, const CharBuffer& nodename);
-    void report_fence_action_result(const char* action, const CharBuffer& nodename, bool success_flag);
+    // Serializes fencing actions affecting the same node, coalesces identical concurrent fencing actions
+    // and caches the results of successful fencing actions if enabled by the fence_cache_ttl parameter
+    FenceFlightTable flight_table;
+
+    bool fence_action_impl(const char* action, plugin::fence_call fence_call, const CharBuffer& nodename) noexcept;
+    bool fence_batch_impl(
+        const char* action,
+        plugin::fence_batch_call batch_call,
+        const char* const* nodename_list,
+        const size_t* nodename_length_list,
+        size_t node_count,
+        bool* result_list
+    ) noexcept;
+
+    void report_fence_action(const char* action, const char* nodename);
+    void report_fence_action_result(const char* action, const char* nodename, bool success_flag);
+    void report_fence_action_coalesced(const char* action, const char* nodename);
+    void report_fence_action_cached(const char* action, const char* nodename);
 };
 
 #endif /* SERVER_H */
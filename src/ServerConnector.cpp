@@ -2,6 +2,9 @@
 #include <iostream>
 #include <algorithm>
 #include <limits>
+#include <string>
+
+#include <RangeException.h>
 
 #include "ServerConnector.h"
 #include "Shared.h"
@@ -15,51 +18,114 @@ extern "C"
     #include <unistd.h>
     #include <fcntl.h>
     #include <errno.h>
-    #include <sys/select.h>
     #include <sys/types.h>
     #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/un.h>
+    #include <sys/uio.h>
+    #include <sys/eventfd.h>
 }
 
-const size_t ServerConnector::MAX_CONNECTIONS               = 24;
-const size_t ServerConnector::MAX_CONNECTION_BACKLOG        = 24;
-
-const size_t ServerConnector::NetClient::IO_BUFFER_SIZE     = 1024;
-const size_t ServerConnector::NetClient::FIELD_SIZE         = 1024;
-const size_t ServerConnector::NetClient::NODENAME_SIZE     = 255;
-
-// @throws std::bad_alloc, InetException
+const size_t ServerConnector::CLIENT_SLAB_SIZE              = 16;
+const size_t ServerConnector::REQUEST_SLAB_SIZE             = 64;
+const size_t ServerConnector::BATCH_SLAB_SIZE               = 4;
+const size_t ServerConnector::MAX_PIPELINE_DEPTH            = 8;
+const size_t ServerConnector::MAX_SELECTOR_EVENTS           = 64;
+// Milliseconds
+const int ServerConnector::TIMER_TICK_LENGTH                = 100;
+
+const size_t ServerConnector::NetRequest::IO_BUFFER_SIZE    = 1024;
+const size_t ServerConnector::NetRequest::FIELD_SIZE        = 1024;
+const size_t ServerConnector::NetRequest::NODENAME_SIZE     = 255;
+const socklen_t ServerConnector::NetClient::ADDRESS_SIZE    = sizeof (struct sockaddr_storage);
+const size_t ServerConnector::NetClient::RECV_BUFFER_SIZE   = 4096;
+
+// @throws std::bad_alloc, InetException, ProtocolException
 ServerConnector::ServerConnector(
     Server& server_ref,
     SignalHandler& stop_signal_ref,
-    const CharBuffer& protocol_string,
-    const CharBuffer& ip_string,
-    const CharBuffer& port_string
-)
+    const Endpoint* const endpoint_list,
+    const size_t endpoint_count,
+    const bool local_listeners_flag,
+    const uid_t allowed_peer_uid,
+    const SelectorBackend::Type selector_type,
+    const bool reuse_port_flag,
+    const size_t max_connections_limit,
+    const size_t connection_backlog,
+    const size_t idle_timeout_secs,
+    const size_t recv_timeout_secs,
+    const size_t send_timeout_secs
+):
+    deadline_wheel(0),
+    client_pool(CLIENT_SLAB_SIZE, max_connections_limit),
+    request_pool(REQUEST_SLAB_SIZE, max_connections_limit * MAX_PIPELINE_DEPTH),
+    node_pool(REQUEST_SLAB_SIZE, max_connections_limit),
+    batch_pool(BATCH_SLAB_SIZE, max_connections_limit * MAX_PIPELINE_DEPTH)
 {
     std::cout << ufh::LOGPFX_START << "Initializing network connector" << std::endl;
 
     ufh_server = &server_ref;
     stop_signal = &stop_signal_ref;
-
-    selector_trigger[sys::PIPE_READ_END] = sys::FD_NONE;
-    selector_trigger[sys::PIPE_WRITE_END] = sys::FD_NONE;
-
-    init_socket_address(protocol_string, ip_string, port_string, socket_domain, address_mgr, address, address_length);
-
-    if (socket_domain == AF_INET6)
+    socket_tuning = &(server_ref.get_socket_tuning());
+    reuse_port = reuse_port_flag;
+    peer_uid = allowed_peer_uid;
+    max_connections = max_connections_limit;
+    backlog_length = connection_backlog;
+    const uint64_t ticks_per_sec = 1000 / TIMER_TICK_LENGTH;
+    idle_timeout = static_cast<uint64_t> (idle_timeout_secs) * ticks_per_sec;
+    recv_timeout = static_cast<uint64_t> (recv_timeout_secs) * ticks_per_sec;
+    send_timeout = static_cast<uint64_t> (send_timeout_secs) * ticks_per_sec;
+    timer_base = std::chrono::steady_clock::now();
+
+    wakeup_pending.store(false);
+
+    listener_list_mgr = std::unique_ptr<Listener[]>(new Listener[endpoint_count]);
+    listener_list = listener_list_mgr.get();
+    bool have_local_listeners = false;
+    for (size_t idx = 0; idx < endpoint_count; ++idx)
     {
-        clients_init_ipv6();
+        const Endpoint& endpoint = endpoint_list[idx];
+        const bool local_flag = endpoint.is_unix_socket();
+        if (!local_flag || local_listeners_flag)
+        {
+            Listener& listener = listener_list[listener_count];
+            init_socket_address(
+                endpoint.protocol, endpoint.address, endpoint.port,
+                listener.socket_domain, listener.address_mgr, listener.address, listener.address_length
+            );
+            ++listener_count;
+            have_local_listeners = have_local_listeners || local_flag;
+            // If there are both IPv4 and IPv6 listeners, IPv6 listeners must not accept IPv4 connections,
+            // which would otherwise prevent binding IPv4 listeners to the same port
+            have_ipv4_listeners = have_ipv4_listeners || listener.socket_domain == AF_INET;
+
+            std::cout << ufh::LOGPFX_CONT << "Listener endpoint = " << endpoint.protocol.c_str() << " " <<
+                endpoint.address.c_str();
+            if (!local_flag)
+            {
+                std::cout << " port " << endpoint.port.c_str();
+            }
+            std::cout << std::endl;
+        }
     }
-    else
-    if (socket_domain == AF_INET)
+    if (have_local_listeners)
     {
-        clients_init_ipv4();
+        std::cout << ufh::LOGPFX_CONT << "Local connections are accepted from uid 0, " << geteuid() <<
+            " and " << peer_uid << std::endl;
     }
-
-    read_fd_set_mgr = std::unique_ptr<fd_set>(new fd_set);
-    write_fd_set_mgr = std::unique_ptr<fd_set>(new fd_set);
-    read_fd_set = read_fd_set_mgr.get();
-    write_fd_set = write_fd_set_mgr.get();
+    std::cout << ufh::LOGPFX_CONT << "Maximum connections = " << max_connections <<
+        ", connection backlog = " << backlog_length << std::endl;
+    std::cout << ufh::LOGPFX_CONT << "Idle connections timeout = " << idle_timeout_secs << " seconds" << std::endl;
+    std::cout << ufh::LOGPFX_CONT << "Receive timeout = " << recv_timeout_secs << " seconds, send timeout = " <<
+        send_timeout_secs << " seconds" << std::endl;
+
+    selector = std::unique_ptr<SelectorBackend>(SelectorBackend::create(selector_type));
+    selector_events_mgr = std::unique_ptr<SelectorBackend::Event[]>(new SelectorBackend::Event[MAX_SELECTOR_EVENTS]);
+    selector_events = selector_events_mgr.get();
+    frame_header_mgr = std::unique_ptr<char[]>(new char[MsgHeader::HEADER_SIZE]);
+    frame_header_data = frame_header_mgr.get();
+    init_version_fields();
+    std::cout << ufh::LOGPFX_CONT << "Selector backend = " << selector->get_name() << std::endl;
 
     invocation_obj = std::unique_ptr<WorkerThreadInvocation>(new WorkerThreadInvocation(this));
 }
@@ -67,12 +133,16 @@ ServerConnector::ServerConnector(
 ServerConnector::~ServerConnector() noexcept
 {
     std::cout << ufh::LOGPFX_STOP << "Uninitializing network connector" << std::endl;
-    sys::close_fd(socket_fd);
+    for (size_t idx = 0; idx < listener_count; ++idx)
+    {
+        sys::close_fd(listener_list[idx].socket_fd);
+    }
 }
 
 // @throws InetException, OsException
 void ServerConnector::run(WorkerPool& thread_pool)
 {
+    worker_pool = &thread_pool;
     try
     {
         std::cout << ufh::LOGPFX_START << "Starting network connector" << std::endl;
@@ -90,238 +160,491 @@ void ServerConnector::run(WorkerPool& thread_pool)
     cleanup();
 }
 
+// @throws InetException
+void ServerConnector::check_listener_addresses()
+{
+    for (size_t idx = 0; idx < listener_count; ++idx)
+    {
+        const Listener& listener = listener_list[idx];
+        if (listener.socket_domain != AF_UNIX &&
+            !socket_setup::probe_bind(
+                listener.socket_domain, listener.address, listener.address_length, have_ipv4_listeners
+            ))
+        {
+            std::cerr << ufh::LOGPFX_ERROR << "The address and port of a listener endpoint are already in use, "
+                "reactor shards do not share them with other sockets" << std::endl;
+            throw InetException(InetException::ErrorId::BIND_FAILED);
+        }
+    }
+}
+
 // @throws InetException, OsException
 void ServerConnector::init()
 {
-    socket_fd = socket(socket_domain, SOCK_STREAM, 0);
-    if (socket_fd < 0)
+    for (size_t idx = 0; idx < listener_count; ++idx)
     {
-        throw InetException(InetException::ErrorId::SOCKET_ERROR);
+        init_listener(listener_list[idx]);
+    }
+
+    selector_trigger = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (selector_trigger < 0)
+    {
+        throw OsException(OsException::ErrorId::IPC_ERROR);
     }
+    wakeup_pending.store(false);
 
-    socket_setup::set_no_linger(socket_fd);
+    selector->init();
+    selector->register_fd(selector_trigger, SelectorBackend::Interest::READ, &wakeup_target);
+}
 
-    if (bind(socket_fd, address, address_length) != 0)
+// @throws InetException, OsException
+void ServerConnector::init_listener(Listener& listener)
+{
+    listener.socket_fd = socket(listener.socket_domain, SOCK_STREAM, 0);
+    if (listener.socket_fd < 0)
     {
-        throw InetException(InetException::ErrorId::BIND_FAILED);
+        throw InetException(InetException::ErrorId::SOCKET_ERROR);
     }
 
-    if (fcntl(socket_fd, F_SETFL, O_NONBLOCK) != 0)
+    const bool unix_socket = listener.socket_domain == AF_UNIX;
+    if (unix_socket)
     {
-        throw OsException(OsException::ErrorId::NBLK_IO_ERROR);
+        socket_setup::remove_stale_socket(listener.address, listener.address_length);
+    }
+    else
+    {
+        socket_setup::set_no_linger(listener.socket_fd);
+
+        if (listener.socket_domain == AF_INET6 && have_ipv4_listeners &&
+            !socket_setup::set_ipv6_only(listener.socket_fd))
+        {
+            throw InetException(InetException::ErrorId::SOCKET_ERROR);
+        }
+
+        if (reuse_port && !socket_setup::set_reuse_port(listener.socket_fd))
+        {
+            throw InetException(InetException::ErrorId::SOCKET_ERROR);
+        }
+
+        socket_tuning->tune_listener(listener.socket_fd);
     }
 
-    if (listen(socket_fd, ServerConnector::MAX_CONNECTION_BACKLOG) != 0)
+    if (bind(listener.socket_fd, listener.address, listener.address_length) != 0)
     {
-        throw InetException(InetException::ErrorId::LISTEN_ERROR);
+        throw InetException(InetException::ErrorId::BIND_FAILED);
     }
+    listener.bound = true;
 
-    if (pipe(selector_trigger) != 0)
+    // Any local user may connect to the socket, the peer credentials are checked when the connection
+    // is accepted
+    if (unix_socket)
     {
-        throw OsException(OsException::ErrorId::IPC_ERROR);
+        const struct sockaddr_un* const unix_address = reinterpret_cast<const struct sockaddr_un*> (listener.address);
+        if (chmod(unix_address->sun_path, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH) != 0)
+        {
+            throw InetException(InetException::ErrorId::SOCKET_ERROR);
+        }
     }
-    if (fcntl(selector_trigger[sys::PIPE_READ_END], F_SETFL, O_NONBLOCK) != 0 ||
-        fcntl(selector_trigger[sys::PIPE_WRITE_END], F_SETFL, O_NONBLOCK) != 0)
+
+    if (fcntl(listener.socket_fd, F_SETFL, O_NONBLOCK) != 0)
     {
         throw OsException(OsException::ErrorId::NBLK_IO_ERROR);
     }
+
+    if (listen(listener.socket_fd, static_cast<int> (backlog_length)) != 0)
+    {
+        throw InetException(InetException::ErrorId::LISTEN_ERROR);
+    }
+
+    listener.active = false;
+    listener.accept_pending = false;
 }
 
 // @throws InetException, OsException
 void ServerConnector::selector_loop(WorkerPool& thread_pool)
 {
-    stop_signal->enable_wakeup_fd(selector_trigger[sys::PIPE_WRITE_END]);
-    while (!stop_signal->is_signaled())
+    if (!stop_signal->enable_wakeup_fd(selector_trigger))
     {
-        FD_ZERO(read_fd_set);
-        FD_ZERO(write_fd_set);
-
-        int max_fd = 0;
-        {
-            FD_SET(selector_trigger[sys::PIPE_READ_END], read_fd_set);
-            max_fd = std::max(max_fd, selector_trigger[sys::PIPE_READ_END]);
+        throw OsException(OsException::ErrorId::IPC_ERROR);
+    }
 
-            std::unique_lock<std::mutex> com_lock(com_queue_lock);
+    // The selector wakes up when the next deadline expires
+    int wait_timeout = SelectorBackend::TIMEOUT_INFINITE;
+    while (!stop_signal->is_signaled())
+    {
+        // Add or remove the server socket, depending on whether there are client objects available
+        update_listener_interest();
 
-            // Add the server socket to the read-selectable set
-            if (client_pool.get_free_count() >= 1)
-            {
-                FD_SET(socket_fd, read_fd_set);
-                max_fd = std::max(max_fd, socket_fd);
-            }
+        // Wait for ready file descriptors
+        const size_t event_count = selector->wait(selector_events, MAX_SELECTOR_EVENTS, wait_timeout);
 
-            // Add active clients to the read/write sets
-            for (NetClient* client = com_queue.get_first(); client != nullptr; client = client->get_next_node())
+        // Perform pending client I/O operations
+        // Only the clients that are ready for I/O are processed
+        bool accept_pending = false;
+        for (size_t idx = 0; idx < event_count; ++idx)
+        {
+            const SelectorBackend::Event& ready_event = selector_events[idx];
+            switch (ready_event.target->target_kind)
             {
-                if (client->io_state == NetClient::IoOp::READ)
-                {
-                    FD_SET(client->socket_fd, read_fd_set);
-                    max_fd = std::max(max_fd, client->socket_fd);
-                }
-                else
-                if (client->io_state == NetClient::IoOp::WRITE)
-                {
-                    FD_SET(client->socket_fd, write_fd_set);
-                    max_fd = std::max(max_fd, client->socket_fd);
-                }
+                case SelectorBackend::Target::Kind::CLIENT:
+                    process_client_io(static_cast<NetClient*> (ready_event.target), ready_event, thread_pool);
+                    break;
+                case SelectorBackend::Target::Kind::LISTENER:
+                    static_cast<Listener*> (ready_event.target)->accept_pending = true;
+                    accept_pending = true;
+                    break;
+                case SelectorBackend::Target::Kind::WAKEUP:
+                    clear_selector_trigger();
+                    break;
+                default:
+                    break;
             }
         }
 
-        // Select ready file descriptors
-        if (max_fd >= std::numeric_limits<int>::max())
+        // Queue the replies of requests completed by the worker threads
+        // Completions are processed after clearing the selector_trigger, so that a completion that
+        // is added concurrently either is processed here or triggers another wakeup
+        process_completions();
+
+        // Accept pending connections
+        // Connections are accepted only after processing all events, so that client objects that have
+        // been released while processing the events can not be reused for another connection while
+        // there are still events pending for the previous connection.
+        if (accept_pending)
         {
-            throw OsException(OsException::ErrorId::INVALID_SELECT_FD);
+            accept_connections();
         }
-        ++max_fd;
-        int select_rc = select(max_fd, read_fd_set, write_fd_set, nullptr, nullptr);
-        if (select_rc >= 0)
-        {
-            // Accept pending connections
-            if (FD_ISSET(socket_fd, read_fd_set) != 0)
-            {
-                accept_connection();
-            }
 
-            // Clear the selector trigger pipe
-            if (FD_ISSET(selector_trigger[sys::PIPE_READ_END], read_fd_set) != 0)
-            {
-                char trigger_byte;
-                ssize_t read_count = 0;
-                do
-                {
-                    read_count = read(selector_trigger[sys::PIPE_READ_END], &trigger_byte, 1);
-                }
-                while (read_count >= 0 || (read_count == -1 && errno == EINTR));
-            }
+        // Close connections with expired deadlines
+        process_expired_deadlines();
+        wait_timeout = get_deadline_wait_timeout();
+    }
+}
 
-            // Perform pending client I/O operations
-            {
-                std::unique_lock<std::mutex> lock(com_queue_lock);
+uint64_t ServerConnector::get_current_tick() const noexcept
+{
+    const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - timer_base;
+    return static_cast<uint64_t> (
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count() / TIMER_TICK_LENGTH
+    );
+}
 
-                NetClient* client = com_queue.get_first();
-                NetClient* next_client = nullptr;
-                while (client != nullptr)
-                {
-                    // The client may be removed from the queue during I/O operations,
-                    // so get_next_node() must be executed before any I/O operations
-                    next_client = client->get_next_node();
+void ServerConnector::update_client_deadline(NetClient* const client, const bool io_progress)
+{
+    Deadline deadline = Deadline::NONE;
+    if (client->send_queue.get_size() > 0)
+    {
+        deadline = Deadline::SEND;
+    }
+    else
+    if (client->is_receiving() && client->recv_buffer.get_length() > 0)
+    {
+        deadline = Deadline::RECV;
+    }
+    else
+    if (client->active_count == 0)
+    {
+        deadline = Deadline::IDLE;
+    }
 
-                    if (client->current_phase == NetClient::Phase::CANCELED)
-                    {
-                        close_connection(client);
-                    }
-                    else
-                    if (FD_ISSET(client->socket_fd, read_fd_set) != 0)
-                    {
-                        // Client ready for receive
-                        bool recv_complete = receive_message(client);
-                        if (recv_complete)
-                        {
-                            client->current_phase = client->next_phase;
-
-                            if (client->current_phase == NetClient::Phase::CANCELED)
-                            {
-                                close_connection(client);
-                            }
-                            else
-                            if (client->current_phase == NetClient::Phase::PENDING)
-                            {
-                                com_queue.remove(client);
-                                client->io_state = NetClient::IoOp::NOOP;
-
-                                std::unique_lock<std::mutex> action_lock(action_queue_lock);
-                                action_queue.add_last(client);
-                                thread_pool.notify();
-                            }
-                        }
-                    }
-                    else
-                    if (FD_ISSET(client->socket_fd, write_fd_set) != 0)
-                    {
-                        // Client ready for send
-                        bool send_complete = send_message(client);
-                        if (send_complete)
-                        {
-                            client->current_phase = client->next_phase;
-
-                            if (client->current_phase == NetClient::Phase::CANCELED)
-                            {
-                                close_connection(client);
-                            }
-                            else
-                            if (client->current_phase == NetClient::Phase::RECV)
-                            {
-                                client->clear_io_buffer();
-                                client->next_phase = NetClient::Phase::PENDING;
-                                client->io_state = NetClient::IoOp::READ;
-                            }
-                        }
-                    }
+    // The receive and send deadlines limit the time without progress, the idle deadline limits the
+    // time since the connection became idle
+    if (deadline != client->deadline || (io_progress && deadline != Deadline::IDLE))
+    {
+        set_client_deadline(client, deadline);
+    }
+}
 
-                    client = next_client;
-                }
+void ServerConnector::set_client_deadline(NetClient* const client, const Deadline deadline)
+{
+    uint64_t timeout = 0;
+    switch (deadline)
+    {
+        case Deadline::IDLE:
+            timeout = idle_timeout;
+            break;
+        case Deadline::RECV:
+            timeout = recv_timeout;
+            break;
+        case Deadline::SEND:
+            timeout = send_timeout;
+            break;
+        case Deadline::NONE:
+            // fall-through
+        default:
+            break;
+    }
+
+    client->deadline = deadline;
+    if (timeout > 0)
+    {
+        deadline_wheel.arm(client, get_current_tick() + timeout);
+    }
+    else
+    {
+        deadline_wheel.cancel(client);
+    }
+}
+
+void ServerConnector::process_expired_deadlines()
+{
+    ServerStats& stats = ufh_server->get_stats();
+    TimerWheel::Timer* timer = deadline_wheel.advance(get_current_tick());
+    while (timer != nullptr)
+    {
+        TimerWheel::Timer* const next_timer = timer->get_next_expired();
+        NetClient* const client = static_cast<NetClient*> (timer);
+        switch (client->deadline)
+        {
+            case Deadline::IDLE:
+                ++(stats.idle_timeouts);
+                break;
+            case Deadline::RECV:
+                ++(stats.recv_timeouts);
+                break;
+            case Deadline::SEND:
+                ++(stats.send_timeouts);
+                break;
+            case Deadline::NONE:
+                // fall-through
+            default:
+                break;
+        }
+        com_queue.remove(client);
+        close_connection(client);
+        timer = next_timer;
+    }
+}
+
+int ServerConnector::get_deadline_wait_timeout() const noexcept
+{
+    int wait_timeout = SelectorBackend::TIMEOUT_INFINITE;
+    const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - timer_base;
+    const uint64_t elapsed_msecs = static_cast<uint64_t> (
+        std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count()
+    );
+    const uint64_t now_tick = elapsed_msecs / TIMER_TICK_LENGTH;
+    const uint64_t ticks = deadline_wheel.get_ticks_to_next_event(now_tick);
+    if (ticks != TimerWheel::NO_EVENT)
+    {
+        // Wait until the start of the tick of the next event
+        const uint64_t event_msecs = (now_tick + ticks) * TIMER_TICK_LENGTH;
+        const uint64_t wait_msecs = event_msecs > elapsed_msecs ? event_msecs - elapsed_msecs : 0;
+        wait_timeout = static_cast<int> (std::min(wait_msecs, static_cast<uint64_t> (std::numeric_limits<int>::max())));
+    }
+    return wait_timeout;
+}
+
+// @throws OsException
+void ServerConnector::process_client_io(
+    NetClient* const client,
+    const SelectorBackend::Event& ready_event,
+    WorkerPool& thread_pool
+)
+{
+    // Ignore events for connections that have been closed by a worker thread
+    // after the selector collected the events
+    if (client->socket_fd != sys::FD_NONE && !client->closed)
+    {
+        bool open_flag = true;
+        bool io_progress = false;
+        if (ready_event.readable && client->is_receiving())
+        {
+            open_flag = receive_request(client, thread_pool, io_progress);
+        }
+        // Replies that were constructed directly by dispatch_request() are sent without waiting for the
+        // socket to become writable; if the socket's send buffer is full, the replies remain queued
+        if (open_flag && client->send_queue.get_size() > 0)
+        {
+            open_flag = send_replies(client, thread_pool, io_progress);
+            if (open_flag && client->is_receiving() && client->recv_buffer.get_length() > 0)
+            {
+                // Requests that were received while the client was not receiving
+                open_flag = process_received_frames(client, thread_pool);
             }
         }
-        else
-        if (errno != EINTR)
+        if (open_flag)
         {
-            throw OsException(OsException::ErrorId::IO_ERROR);
+            update_client_interest(client);
+            update_client_deadline(client, io_progress);
         }
     }
 }
 
-// Caller must hold the com_queue_lock to avoid concurrent close of the selector_trigger pipe
-// by the cleanup() method
+// @throws OsException
+void ServerConnector::update_listener_interest()
+{
+    const bool have_free_clients = client_pool.get_free_count() >= 1;
+    for (size_t idx = 0; idx < listener_count; ++idx)
+    {
+        Listener& listener = listener_list[idx];
+        if (have_free_clients != listener.active)
+        {
+            selector->modify_fd(
+                listener.socket_fd,
+                have_free_clients ? SelectorBackend::Interest::READ : SelectorBackend::Interest::NONE,
+                &listener
+            );
+            listener.active = have_free_clients;
+        }
+    }
+}
+
+// @throws OsException
+void ServerConnector::update_client_interest(NetClient* const client)
+{
+    const bool read_flag = client->is_receiving();
+    const bool write_flag = client->send_queue.get_size() > 0;
+    SelectorBackend::Interest interest = SelectorBackend::Interest::NONE;
+    if (read_flag && write_flag)
+    {
+        interest = SelectorBackend::Interest::READ_WRITE;
+    }
+    else
+    if (read_flag)
+    {
+        interest = SelectorBackend::Interest::READ;
+    }
+    else
+    if (write_flag)
+    {
+        interest = SelectorBackend::Interest::WRITE;
+    }
+
+    if (interest != client->interest)
+    {
+        selector->modify_fd(client->socket_fd, interest, client);
+        client->interest = interest;
+    }
+}
+
+void ServerConnector::clear_selector_trigger() noexcept
+{
+    // The pending flag must be cleared before resetting the eventfd, so that a wakeup that is requested
+    // concurrently either triggers the eventfd again or is consumed by this reset, but is never lost
+    wakeup_pending.store(false);
+
+    // A single read resets the eventfd's counter, regardless of the number of wakeups
+    uint64_t trigger_value = 0;
+    ssize_t read_count = 0;
+    do
+    {
+        read_count = read(selector_trigger, &trigger_value, sizeof (trigger_value));
+    }
+    while (read_count == -1 && errno == EINTR);
+}
+
 void ServerConnector::wakeup_selector()
 {
-    if (selector_trigger[sys::PIPE_WRITE_END] != sys::FD_NONE)
+    if (!wakeup_pending.exchange(true))
     {
-        // Write a byte to the pipe to wake up the selector
-        // Failure to write because there is no space in the pipe is ignored, because then the selector will
-        // wake up anyway. Failure to write due to an interrupted system call causes a retry.
-        ssize_t write_length = 0;
-        do
+        // The trigger_lock prevents concurrent close of the selector_trigger eventfd by the cleanup() method
+        std::unique_lock<std::mutex> lock(trigger_lock);
+        if (selector_trigger != sys::FD_NONE)
         {
-            write_length = write(selector_trigger[sys::PIPE_WRITE_END], &ufh::WAKEUP_TRIGGER_BYTE, 1);
+            // Add to the eventfd's counter to wake up the selector
+            // Failure to write due to an overflow of the counter is ignored, because then the selector will
+            // wake up anyway. Failure to write due to an interrupted system call causes a retry.
+            ssize_t write_length = 0;
+            do
+            {
+                write_length = write(
+                    selector_trigger, &ufh::WAKEUP_TRIGGER_VALUE, sizeof (ufh::WAKEUP_TRIGGER_VALUE)
+                );
+            }
+            while (write_length == -1 && errno == EINTR);
         }
-        while (write_length == -1 && errno == EINTR);
     }
 }
 
 void ServerConnector::cleanup()
 {
-    // Close the server socket
-    sys::close_fd(socket_fd);
-
-    // Close connections of clients on the action queue
+    // Close the server sockets
+    for (size_t idx = 0; idx < listener_count; ++idx)
     {
-        std::unique_lock<std::mutex> action_lock(action_queue_lock);
-        for (NetClient* client = action_queue.remove_first(); client != nullptr; client = action_queue.remove_first())
+        Listener& listener = listener_list[idx];
+        if (listener.socket_fd != sys::FD_NONE)
         {
-            close_connection(client);
+            selector->unregister_fd(listener.socket_fd);
+            sys::close_fd(listener.socket_fd);
+        }
+        listener.active = false;
+        if (listener.bound && listener.socket_domain == AF_UNIX)
+        {
+            const struct sockaddr_un* const unix_address =
+                reinterpret_cast<const struct sockaddr_un*> (listener.address);
+            unlink(unix_address->sun_path);
         }
+        listener.bound = false;
     }
 
     // Close connections of clients on the com queue
-    // Notify worker threads to close connections of clients that are currently being processed
+    // Requests that are completed by the worker threads afterwards are not processed anymore
     {
-        std::unique_lock<std::mutex> com_lock(com_queue_lock);
-        stop_signal->disable_wakeup_fd();
+        stop_signal->disable_wakeup_fd(selector_trigger);
         stop_signal->signal();
 
+        // Release requests that have already been completed
+        try
+        {
+            process_completions();
+        }
+        catch (OsException&)
+        {
+            // Not reachable, no replies are queued for sending while the stop signal is set
+        }
+
         for (NetClient* client = com_queue.remove_first(); client != nullptr; client = com_queue.remove_first())
         {
             close_connection(client);
         }
 
-        // Close the selector trigger pipe
-        sys::close_fd(selector_trigger[sys::PIPE_READ_END]);
-        sys::close_fd(selector_trigger[sys::PIPE_WRITE_END]);
+        // Release requests that are still queued on the worker pool
+        // Clients that have requests being processed by worker threads are released when the worker
+        // threads complete those requests
+        for (WorkerPool::Task* task = worker_pool->take(); task != nullptr; task = worker_pool->take())
+        {
+            NetRequest* const request = static_cast<NetRequest*> (task);
+            if (request->batch_request != nullptr)
+            {
+                // The client's connection is closed, so the node request is released without
+                // being executed
+                NetRequest* const batch_request = process_batch_node(request);
+                if (batch_request != nullptr)
+                {
+                    release_request(batch_request);
+                }
+            }
+            else
+            {
+                release_request(request);
+            }
+        }
+
+        // Close the selector trigger eventfd
+        std::unique_lock<std::mutex> lock(trigger_lock);
+        selector->unregister_fd(selector_trigger);
+        sys::close_fd(selector_trigger);
     }
 }
 
-void ServerConnector::accept_connection()
+void ServerConnector::accept_connections()
 {
+    // Drain the queue of pending connections, until either there are no more pending connections
+    // or all client objects are in use
+    for (size_t idx = 0; idx < listener_count; ++idx)
+    {
+        Listener& listener = listener_list[idx];
+        while (listener.accept_pending && client_pool.get_free_count() >= 1)
+        {
+            listener.accept_pending = accept_connection(listener);
+        }
+    }
+}
+
+bool ServerConnector::accept_connection(Listener& listener)
+{
+    bool accept_pending = false;
     try
     {
         ClientAlloc::scope_ptr new_client = client_pool.allocate_scope();
@@ -332,322 +655,1045 @@ void ServerConnector::accept_connection()
         }
 
         new_client_ptr->clear();
-        new_client_ptr->socket_fd = accept(socket_fd, new_client_ptr->address, &(new_client_ptr->address_length));
-        new_client_ptr->socket_domain = socket_domain;
-        new_client_ptr->io_state = NetClient::IoOp::READ;
-        new_client_ptr->current_phase = NetClient::Phase::RECV;
-        new_client_ptr->next_phase = NetClient::Phase::PENDING;
+        new_client_ptr->address_length = NetClient::ADDRESS_SIZE;
+        new_client_ptr->socket_fd = accept4(
+            listener.socket_fd, new_client_ptr->address, &(new_client_ptr->address_length),
+            SOCK_NONBLOCK | SOCK_CLOEXEC
+        );
+        if (new_client_ptr->socket_fd < 0)
+        {
+            new_client_ptr->socket_fd = sys::FD_NONE;
+            // Continue accepting if the connection was aborted by the peer before it was accepted,
+            // stop if there are no more pending connections or if accepting failed for some other reason
+            accept_pending = errno == ECONNABORTED || errno == EPROTO || errno == EINTR;
+            return accept_pending;
+        }
+        accept_pending = true;
+        if (listener.socket_domain == AF_UNIX && !check_peer_credentials(new_client_ptr->socket_fd))
+        {
+            sys::close_fd(new_client_ptr->socket_fd);
+            return accept_pending;
+        }
+        new_client_ptr->socket_domain = listener.socket_domain;
+        if (listener.socket_domain != AF_UNIX)
+        {
+            socket_tuning->tune_connection(new_client_ptr->socket_fd, false);
+        }
+        new_client_ptr->interest = SelectorBackend::Interest::READ;
 
+        try
+        {
+            selector->register_fd(new_client_ptr->socket_fd, SelectorBackend::Interest::READ, new_client_ptr);
+        }
+        catch (OsException&)
         {
-            std::unique_lock<std::mutex> lock(com_queue_lock);
-            com_queue.add_last(new_client_ptr);
+            sys::close_fd(new_client_ptr->socket_fd);
+            throw;
         }
+        com_queue.add_last(new_client_ptr);
+        set_client_deadline(new_client_ptr, Deadline::IDLE);
 
         new_client.release();
     }
+    catch (OsException&)
+    {
+        std::cerr << ufh::LOGPFX_WARNING << "Selector registration failed for a new connection, "
+            "closing the connection" << std::endl;
+    }
     catch (std::bad_alloc&)
     {
-        // This section should not be unreachable, since MAX_CONNECTIONS == client_pool size
+        // This section should be unreachable, since accepting connections stops when there
+        // are no more free client objects
         std::cerr << ufh::LOGPFX_ERROR << "Unexpected error: ServerConnector: accept_connection: "
             "Client object allocation failed" << std::endl;
+        accept_pending = false;
+    }
+    return accept_pending;
+}
+
+bool ServerConnector::check_peer_credentials(const int socket_fd)
+{
+    uid_t client_uid = 0;
+    bool allowed = false;
+    if (socket_setup::get_peer_uid(socket_fd, client_uid))
+    {
+        allowed = client_uid == 0 || client_uid == geteuid() || client_uid == peer_uid;
+        if (!allowed)
+        {
+            std::cerr << ufh::LOGPFX_WARNING << "Rejected local connection from uid " << client_uid <<
+                std::endl;
+        }
     }
+    else
+    {
+        std::cerr << ufh::LOGPFX_WARNING << "Rejected local connection, peer credentials are not available" <<
+            std::endl;
+    }
+    return allowed;
 }
 
-// Caller must have locked the client_queue_lock
+// Closes the client's socket and releases all requests that are not being executed
+// The client object is released if no requests are being executed
+// The client must not be a member of any queue
 void ServerConnector::close_connection(NetClient* const client)
 {
-    sys::close_fd(client->socket_fd);
+    {
+        // Wait for a worker thread that is sending a reply directly
+        std::unique_lock<std::mutex> lock(client->send_lock);
+        selector->unregister_fd(client->socket_fd);
+        sys::close_fd(client->socket_fd);
+        client->closed = true;
+    }
+    client->interest = SelectorBackend::Interest::NONE;
+    deadline_wheel.cancel(client);
+    client->deadline = Deadline::NONE;
+
+    client->recv_buffer.clear();
+
+    if (client->held_request != nullptr)
+    {
+        client->held_request->clear();
+        request_pool.deallocate(client->held_request);
+        client->held_request = nullptr;
+        --(client->active_count);
+    }
 
-    com_queue.remove(client);
+    for (NetRequest* request = client->send_queue.remove_first(); request != nullptr;
+         request = client->send_queue.remove_first())
+    {
+        request->clear();
+        request_pool.deallocate(request);
+        --(client->active_count);
+    }
 
-    client->clear();
-    client_pool.deallocate(client);
+    if (client->active_count == 0)
+    {
+        client->clear();
+        client_pool.deallocate(client);
+    }
 }
 
-bool ServerConnector::receive_message(NetClient* const client)
+// Releases a request that is not a member of any queue
+// If the request was the last active request of a closed client, the client object is released
+void ServerConnector::release_request(NetRequest* const request)
 {
-    bool recv_complete_flag = false;
+    NetClient* const client = request->client;
+    request->clear();
+    request_pool.deallocate(request);
 
-    const size_t req_read_size = client->io_offset < MsgHeader::HEADER_SIZE ?
-        MsgHeader::HEADER_SIZE - client->io_offset :
-        client->header.data_length - client->io_offset;
-    const ssize_t read_size = recv(
-        client->socket_fd,
-        &(client->io_buffer[client->io_offset]),
-        req_read_size,
-        0 // Flags
-    );
-    if (read_size > 0)
+    --(client->active_count);
+    if (client->closed && client->active_count == 0)
     {
-        client->io_offset += static_cast<size_t> (read_size);
+        client->clear();
+        client_pool.deallocate(client);
+    }
+}
 
-        if (client->have_header)
-        {
-            if (client->io_offset >= client->header.data_length)
-            {
-                recv_complete_flag = true;
-            }
-        }
-        else
-        if (client->io_offset >= MsgHeader::HEADER_SIZE)
-        {
-            client->header.deserialize(client->io_buffer);
-            if (client->header.data_length > NetClient::IO_BUFFER_SIZE)
-            {
-                client->header.data_length = NetClient::IO_BUFFER_SIZE;
-            }
-            client->have_header = true;
+// Returns false if the connection was closed
+bool ServerConnector::receive_request(NetClient* const client, WorkerPool& thread_pool, bool& io_progress)
+{
+    bool open_flag = true;
 
-            if (client->header.data_length <= MsgHeader::HEADER_SIZE)
-            {
-                recv_complete_flag = true;
-            }
+    const ssize_t read_size = client->recv_buffer.receive(client->socket_fd, 0);
+    if (read_size > 0)
+    {
+        io_progress = true;
+        if (client->socket_domain != AF_UNIX)
+        {
+            socket_tuning->rearm_quickack(client->socket_fd);
         }
+        open_flag = process_received_frames(client, thread_pool);
     }
     else
+    if (read_size == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR))
     {
         // read_size == 0: End of stream
-        // read_size <= 0: I/O error
+        // read_size < 0: I/O error, or the receive buffer is full, which is unreachable, because a
+        // receive buffer that contains a complete request is not read from
+        com_queue.remove(client);
         close_connection(client);
+        open_flag = false;
     }
+    // else: No data available yet (spurious readiness), or the system call was interrupted
 
-    return recv_complete_flag;
+    return open_flag;
 }
 
-bool ServerConnector::send_message(NetClient* const client)
+// Returns false if the connection was closed
+bool ServerConnector::process_received_frames(NetClient* const client, WorkerPool& thread_pool)
 {
-    bool send_complete_flag = false;
-
-    if (!client->have_header)
+    bool open_flag = true;
+    while (open_flag && client->is_receiving() && client->recv_buffer.get_length() >= MsgHeader::HEADER_SIZE)
     {
-        if (client->header.data_length < MsgHeader::HEADER_SIZE)
+        frame_header.clear();
+        client->recv_buffer.peek(frame_header_data, MsgHeader::HEADER_SIZE);
+        frame_header.deserialize(frame_header_data);
+
+        const size_t frame_length = frame_header.data_length;
+        if (frame_length < frame_header.get_header_size() || frame_length > NetRequest::IO_BUFFER_SIZE)
         {
-            client->header.data_length = static_cast<uint16_t> (MsgHeader::HEADER_SIZE);
+            // Protocol error, kick the client out
+            std::cerr << ufh::LOGPFX_WARNING << "Invalid request from client with socket_fd = " <<
+                client->socket_fd << ", invalid message length " << frame_length << std::endl;
+            com_queue.remove(client);
+            close_connection(client);
+            open_flag = false;
         }
         else
-        if (client->header.data_length > NetClient::IO_BUFFER_SIZE)
+        if (client->recv_buffer.get_length() >= frame_length)
         {
-            client->header.data_length = static_cast<uint16_t> (NetClient::IO_BUFFER_SIZE);
-        }
-        client->header.serialize(client->io_buffer);
-        client->have_header = true;
-    }
-
-    const size_t req_write_size = std::min(
-        static_cast<uint16_t> (NetClient::IO_BUFFER_SIZE),
-        static_cast<uint16_t> (client->header.data_length - client->io_offset)
-    );
-    const ssize_t write_size = send(
-        client->socket_fd,
-        &(client->io_buffer[client->io_offset]),
-        req_write_size,
-        0 // Flags
-    );
-    if (write_size == -1 && errno != EAGAIN && errno != EWOULDBLOCK)
+            NetRequest* request = nullptr;
+            try
+            {
+                request = request_pool.allocate();
+            }
+            catch (std::bad_alloc&)
+            {
+                // This section should be unreachable, since the request pool is sized for the maximum
+                // pipeline depth of all connections
+                std::cerr << ufh::LOGPFX_ERROR << "Unexpected error: ServerConnector: process_received_frames: "
+                    "Request object allocation failed" << std::endl;
+                com_queue.remove(client);
+                close_connection(client);
+                return false;
+            }
+            request->clear();
+            request->client = client;
+
+            client->recv_buffer.read(request->io_buffer, frame_length);
+            request->io_offset = frame_length;
+            request->header.deserialize(request->io_buffer);
+
+            ++(client->active_count);
+            if (request->header.have_request_id)
+            {
+                request->header.deserialize_request_id(request->io_buffer);
+                dispatch_request(request, thread_pool);
+            }
+            else
+            {
+                // Requests without a request ID are processed one at a time, after all other requests
+                // have been completed, so that the client can match the reply to the request
+                client->serial_mode = true;
+                if (client->active_count == 1)
+                {
+                    dispatch_request(request, thread_pool);
+                }
+                else
+                {
+                    client->held_request = request;
+                }
+            }
+        }
+        else
+        {
+            // Partially received request, continue with the next readiness event
+            break;
+        }
+    }
+    return open_flag;
+}
+
+void ServerConnector::dispatch_request(NetRequest* const request, WorkerPool& thread_pool)
+{
+    if (answer_inline(request))
     {
-        close_connection(client);
+        // The caller updates the client's selector interest and deadline
+        queue_reply(request);
     }
     else
     {
-        if (write_size > 0)
+        request->current_phase = NetRequest::Phase::PENDING;
+
+        // Never fails, because the worker pool is sized for all requests and node requests
+        thread_pool.submit(request, get_priority(request->header.msg_type));
+    }
+}
+
+WorkerPool::Priority ServerConnector::get_priority(const uint16_t msg_type) noexcept
+{
+    WorkerPool::Priority priority = WorkerPool::Priority::LOW;
+    switch (static_cast<protocol::MsgType> (msg_type))
+    {
+        case protocol::MsgType::FENCE_OFF:
+            // fall-through
+        case protocol::MsgType::FENCE_REBOOT:
+            // fall-through
+        case protocol::MsgType::FENCE_OFF_BATCH:
+            // fall-through
+        case protocol::MsgType::FENCE_REBOOT_BATCH:
+            priority = WorkerPool::Priority::HIGH;
+            break;
+        case protocol::MsgType::FENCE_ON:
+            // fall-through
+        case protocol::MsgType::FENCE_ON_BATCH:
+            priority = WorkerPool::Priority::NORMAL;
+            break;
+        default:
+            break;
+    }
+    return priority;
+}
+
+bool ServerConnector::answer_inline(NetRequest* const request) noexcept
+{
+    bool answered = true;
+    request->current_phase = NetRequest::Phase::EXECUTING;
+    switch (static_cast<protocol::MsgType> (request->header.msg_type))
+    {
+        case protocol::MsgType::ECHO_REQUEST:
+            echo_reply(request);
+            break;
+        case protocol::MsgType::VERSION_REQUEST:
+            version_reply(request);
+            break;
+        default:
+            // Fencing requests block in the fencing plugin, the statistics reply is left to the
+            // worker threads, since constructing it involves memory allocations
+            answered = false;
+            break;
+    }
+    return answered;
+}
+
+// Processes the requests that have been completed by the worker threads
+// @throws OsException
+void ServerConnector::process_completions()
+{
+    for (NetRequest* request = completion_queue.pop(); request != nullptr; request = completion_queue.pop())
+    {
+        NetClient* const client = request->client;
+        if (client->closed)
         {
-            client->io_offset += static_cast<size_t> (write_size);
+            // The connection was closed while the request was being processed
+            release_request(request);
         }
-
-        if (client->io_offset >= client->header.data_length)
+        else
+        if (request == client->partial_reply && !stop_signal->is_signaled())
         {
-            send_complete_flag = true;
+            // The worker thread sent the reply partially, the rest of the reply must be sent
+            // before any other replies
+            client->send_queue.add_first(request);
+            {
+                std::unique_lock<std::mutex> lock(client->send_lock);
+                client->partial_reply = nullptr;
+            }
+            update_client_interest(client);
+            update_client_deadline(client, false);
+        }
+        else
+        if (request->current_phase == NetRequest::Phase::SENT && !stop_signal->is_signaled())
+        {
+            // The worker thread sent the reply
+            finish_reply(request);
+            start_held_request(client, *worker_pool);
+            bool open_flag = true;
+            if (client->is_receiving() && client->recv_buffer.get_length() > 0)
+            {
+                // Requests that were received while the client was not receiving
+                open_flag = process_received_frames(client, *worker_pool);
+            }
+            if (open_flag)
+            {
+                update_client_interest(client);
+                update_client_deadline(client, false);
+            }
+        }
+        else
+        if (request->current_phase == NetRequest::Phase::SEND && !stop_signal->is_signaled())
+        {
+            // Queue the reply for sending
+            complete_request(request);
+        }
+        else
+        {
+            // Protocol error, or the selector loop is stopped (shutdown is in progress),
+            // end client communication
+            com_queue.remove(client);
+            close_connection(client);
+            release_request(request);
         }
     }
+}
 
-    return send_complete_flag;
+// @throws OsException
+void ServerConnector::complete_request(NetRequest* const request)
+{
+    NetClient* const client = request->client;
+    queue_reply(request);
+    update_client_interest(client);
+    update_client_deadline(client, false);
 }
 
-WorkerPool::WorkerPoolExecutor* ServerConnector::get_worker_thread_invocation() noexcept
+void ServerConnector::queue_reply(NetRequest* const request) noexcept
 {
-    return invocation_obj.get();
+    prepare_reply(request);
+
+    NetClient* const client = request->client;
+    client->send_queue.add_last(request);
+
+    std::unique_lock<std::mutex> lock(client->send_lock);
+    client->send_pending = true;
 }
 
-// Caller must have locked the action_queue_lock
-void ServerConnector::process_action_queue() noexcept
+void ServerConnector::prepare_reply(NetRequest* const request) noexcept
 {
-    try
+    if (request->header.data_length < request->header.get_header_size())
+    {
+        request->header.data_length = static_cast<uint16_t> (request->header.get_header_size());
+    }
+    else
+    if (request->header.data_length > NetRequest::IO_BUFFER_SIZE)
     {
-        NetClient* client = action_queue.remove_first();
-        while (client != nullptr)
+        request->header.data_length = static_cast<uint16_t> (NetRequest::IO_BUFFER_SIZE);
+    }
+    request->header.serialize(request->io_buffer);
+    request->io_offset = 0;
+    request->current_phase = NetRequest::Phase::SEND;
+}
+
+void ServerConnector::send_reply_direct(NetRequest* const request) noexcept
+{
+    prepare_reply(request);
+
+    // If the selector thread is currently sending replies, it sends this reply as well
+    NetClient* const client = request->client;
+    std::unique_lock<std::mutex> lock(client->send_lock, std::try_to_lock);
+    if (lock.owns_lock() && !client->send_pending && !client->closed)
+    {
+        const size_t reply_length = request->header.data_length;
+        ssize_t write_size = 0;
+        do
         {
-            action_queue_lock.unlock();
+            write_size = send(client->socket_fd, request->io_buffer, reply_length, MSG_NOSIGNAL | MSG_DONTWAIT);
+        }
+        while (write_size == -1 && errno == EINTR);
 
-            client->current_phase = NetClient::Phase::EXECUTING;
-            process_client_message(client);
+        if (write_size > 0)
+        {
+            if (static_cast<size_t> (write_size) >= reply_length)
+            {
+                request->current_phase = NetRequest::Phase::SENT;
+            }
+            else
+            {
+                // Prevent other worker threads from sending replies until the selector thread
+                // has sent the rest of this reply
+                request->io_offset = static_cast<size_t> (write_size);
+                client->send_pending = true;
+                client->partial_reply = request;
+            }
+        }
+        // else: The socket's send buffer is full, or the connection failed, which is detected by
+        //       the selector thread
+    }
+}
 
-            if (client->current_phase == NetClient::Phase::RECV || client->current_phase == NetClient::Phase::SEND)
+void ServerConnector::finish_reply(NetRequest* const request)
+{
+    NetClient* const client = request->client;
+    if (!request->header.have_request_id)
+    {
+        client->serial_mode = client->held_request != nullptr;
+    }
+    release_request(request);
+}
+
+void ServerConnector::start_held_request(NetClient* const client, WorkerPool& thread_pool)
+{
+    if (client->held_request != nullptr && client->active_count == 1)
+    {
+        NetRequest* const held_request = client->held_request;
+        client->held_request = nullptr;
+        dispatch_request(held_request, thread_pool);
+    }
+}
+
+// Returns false if the connection was closed
+bool ServerConnector::send_replies(NetClient* const client, WorkerPool& thread_pool, bool& io_progress)
+{
+    bool open_flag = true;
+
+    ssize_t write_size = 0;
+    int write_error = 0;
+    {
+        std::unique_lock<std::mutex> lock(client->send_lock);
+        // A reply that was sent partially by a worker thread must be sent completely before any other
+        // replies, therefore no replies are sent until the reply is queued by process_completions()
+        if (client->partial_reply == nullptr)
+        {
+            // Send as many of the queued replies as possible with a single system call
+            struct iovec io_vector[MAX_PIPELINE_DEPTH];
+            size_t io_vector_count = 0;
+            for (NetRequest* request = client->send_queue.get_first();
+                 request != nullptr && io_vector_count < MAX_PIPELINE_DEPTH;
+                 request = request->get_next_node())
             {
-                // Continue client I/O
-                std::unique_lock<std::mutex> com_lock(com_queue_lock);
-                if (!stop_signal->is_signaled())
-                {
-                    com_queue.add_last(client);
+                io_vector[io_vector_count].iov_base = &(request->io_buffer[request->io_offset]);
+                io_vector[io_vector_count].iov_len = request->header.data_length - request->io_offset;
+                ++io_vector_count;
+            }
 
-                    wakeup_selector();
-                }
-                else
+            struct msghdr message;
+            zero_memory(reinterpret_cast<char*> (&message), sizeof (message));
+            message.msg_iov = io_vector;
+            message.msg_iovlen = io_vector_count;
+
+            write_size = sendmsg(client->socket_fd, &message, MSG_NOSIGNAL);
+            write_error = errno;
+            if (write_size > 0)
+            {
+                size_t sent_length = static_cast<size_t> (write_size);
+                NetRequest* request = client->send_queue.get_first();
+                while (request != nullptr && sent_length > 0)
                 {
-                    // The selector loop is stopped (shutdown is in progress), end client communication
-                    close_connection(client);
+                    const size_t pending_length = request->header.data_length - request->io_offset;
+                    if (sent_length >= pending_length)
+                    {
+                        sent_length -= pending_length;
+                        client->send_queue.remove(request);
+                        finish_reply(request);
+                        request = client->send_queue.get_first();
+                    }
+                    else
+                    {
+                        request->io_offset += sent_length;
+                        sent_length = 0;
+                    }
                 }
             }
-            else
+            client->send_pending = client->send_queue.get_size() > 0;
+        }
+    }
+
+    if (write_size > 0)
+    {
+        io_progress = true;
+
+        // Start a held request once all other requests have been completed
+        start_held_request(client, thread_pool);
+    }
+    else
+    if (write_size == -1 && write_error != EAGAIN && write_error != EWOULDBLOCK && write_error != EINTR)
+    {
+        com_queue.remove(client);
+        close_connection(client);
+        open_flag = false;
+    }
+
+    return open_flag;
+}
+
+WorkerPool::WorkerPoolExecutor* ServerConnector::get_worker_thread_invocation() noexcept
+{
+    return invocation_obj.get();
+}
+
+size_t ServerConnector::get_max_connections() const noexcept
+{
+    return max_connections;
+}
+
+size_t ServerConnector::get_max_pending_requests() const noexcept
+{
+    return max_connections * MAX_PIPELINE_DEPTH + max_connections;
+}
+
+void ServerConnector::execute_task(WorkerPool::Task* const task) noexcept
+{
+    try
+    {
+        NetRequest* const request = static_cast<NetRequest*> (task);
+
+        // Request that has been completed by this worker thread
+        NetRequest* completed_request = nullptr;
+        if (request->batch_request != nullptr)
+        {
+            completed_request = process_batch_node(request);
+        }
+        else
+        if (!request->client->closed)
+        {
+            request->current_phase = NetRequest::Phase::EXECUTING;
+            if (process_request(request))
             {
-                // End client communication
-                close_connection(client);
+                completed_request = request;
             }
+        }
+        else
+        {
+            // Requests of clients that have closed the connection are not executed anymore
+            request->current_phase = NetRequest::Phase::CANCELED;
+            completed_request = request;
+        }
 
-            action_queue_lock.lock();
-            client = action_queue.remove_first();
+        if (completed_request != nullptr)
+        {
+            if (completed_request->current_phase == NetRequest::Phase::SEND)
+            {
+                send_reply_direct(completed_request);
+            }
+
+            // Hand the request back to the selector thread, which owns the client connections
+            completion_queue.push(completed_request);
+            wakeup_selector();
         }
     }
     catch (std::exception&)
     {
         std::cerr << ufh::LOGPFX_ERROR << "Unhandled exception caught in class ServerConnector, "
-            "method process_action_queue" << std::endl;
+            "method execute_task" << std::endl;
     }
 }
 
+// Returns false if the request is a batch fence request that is completed by another worker thread
 // @throws ProtocolException
-void ServerConnector::process_client_message(NetClient* const client)
+bool ServerConnector::process_request(NetRequest* const request)
 {
-    switch (static_cast<protocol::MsgType> (client->header.msg_type))
+    bool completed = true;
+    switch (static_cast<protocol::MsgType> (request->header.msg_type))
     {
         case protocol::MsgType::ECHO_REQUEST:
-            client->clear_io_buffer();
-            client->header.msg_type = static_cast<uint16_t> (protocol::MsgType::ECHO_REPLY);
-            client->header.data_length = MsgHeader::HEADER_SIZE;
-            client->current_phase = NetClient::Phase::SEND;
-            client->next_phase = NetClient::Phase::RECV;
-            client->io_state = NetClient::IoOp::WRITE;
+            echo_reply(request);
             break;
         case protocol::MsgType::VERSION_REQUEST:
-            // TODO: Implement version request
+            version_reply(request);
+            break;
+        case protocol::MsgType::STATS_REQUEST:
+            stats_reply(request);
             break;
         case protocol::MsgType::FENCE_OFF:
-            fence_action(&Server::fence_action_off, client);
+            fence_action(&Server::fence_action_off, request);
             break;
         case protocol::MsgType::FENCE_ON:
-            fence_action(&Server::fence_action_on, client);
+            fence_action(&Server::fence_action_on, request);
             break;
         case protocol::MsgType::FENCE_REBOOT:
-            fence_action(&Server::fence_action_reboot, client);
+            fence_action(&Server::fence_action_reboot, request);
+            break;
+        case protocol::MsgType::FENCE_OFF_BATCH:
+            completed = fence_batch_action(&Server::fence_action_off, &Server::fence_batch_off, request);
+            break;
+        case protocol::MsgType::FENCE_ON_BATCH:
+            completed = fence_batch_action(&Server::fence_action_on, &Server::fence_batch_on, request);
+            break;
+        case protocol::MsgType::FENCE_REBOOT_BATCH:
+            completed = fence_batch_action(&Server::fence_action_reboot, &Server::fence_batch_reboot, request);
             break;
         case protocol::MsgType::FENCE_SUCCESS:
             // fall-through
         case protocol::MsgType::FENCE_FAIL:
             // fall-through
+        case protocol::MsgType::FENCE_BATCH_RESULT:
+            // fall-through
         case protocol::MsgType::ECHO_REPLY:
             // fall-through
+        case protocol::MsgType::VERSION_REPLY:
+            // fall-through
+        case protocol::MsgType::STATS_REPLY:
+            // fall-through
         default:
             std::cerr << ufh::LOGPFX_WARNING << "Invalid request from client with socket_fd = " <<
-                client->socket_fd << ", unknwon msg_type = " << client->header.msg_type << std::endl;
+                request->client->socket_fd << ", unknwon msg_type = " << request->header.msg_type << std::endl;
             // Protocol error, kick the client out
-            client->current_phase = NetClient::Phase::CANCELED;
+            request->current_phase = NetRequest::Phase::CANCELED;
             break;
     }
+    return completed;
 }
 
-void ServerConnector::fence_action(const Server::fence_action_method fence, NetClient* const client)
+void ServerConnector::fence_action(const Server::fence_action_method fence, NetRequest* const request)
 {
+    const protocol::DecodeStatus status = decode_fence_fields(request, nullptr);
+    request->clear_io_buffer();
+
+    if (status != protocol::DecodeStatus::OK)
+    {
+        std::cerr << ufh::LOGPFX_WARNING << "Protocol error (" << protocol::get_decode_status_text(status) <<
+            "), client socket_fd = " << request->client->socket_fd << std::endl;
+        request->current_phase = NetRequest::Phase::CANCELED;
+    }
+    else
+    if (request->nodename.length() > 0)
+    {
+        bool success_flag = (ufh_server->*fence)(request->nodename, request->secret);
+
+        request->header.msg_type = success_flag ?
+            static_cast<uint16_t> (protocol::MsgType::FENCE_SUCCESS) :
+            static_cast<uint16_t> (protocol::MsgType::FENCE_FAIL);
+        request->header.data_length = static_cast<uint16_t> (request->header.get_header_size());
+        request->current_phase = NetRequest::Phase::SEND;
+    }
+    else
+    {
+        std::cerr << ufh::LOGPFX_WARNING << "Fence request without a node name from client with socket_fd = " <<
+            request->client->socket_fd << std::endl;
+        request->current_phase = NetRequest::Phase::CANCELED;
+    }
+}
+
+// Returns false if the request is completed by another worker thread
+bool ServerConnector::fence_batch_action(
+    const Server::fence_action_method fence,
+    const Server::fence_batch_method batch_fence,
+    NetRequest* const request
+)
+{
+    bool completed = true;
     try
     {
-        size_t field_offset = client->header.HEADER_SIZE;
-        while (field_offset < client->io_offset)
+        request->batch = batch_pool.allocate();
+        FenceBatch* const batch = request->batch;
+        batch->clear();
+
+        const protocol::DecodeStatus status = decode_fence_fields(request, batch);
+        request->clear_io_buffer();
+
+        if (status != protocol::DecodeStatus::OK)
         {
-            protocol::read_field(client->io_buffer, client->io_offset, field_offset, client->key_buffer);
-            protocol::split_key_value_pair(client->key_buffer, client->value_buffer);
-            if (client->key_buffer == protocol::NODENAME)
+            std::cerr << ufh::LOGPFX_WARNING << "Protocol error (" << protocol::get_decode_status_text(status) <<
+                "), client socket_fd = " << request->client->socket_fd << std::endl;
+            request->current_phase = NetRequest::Phase::CANCELED;
+        }
+        else
+        if (batch->node_count > 0)
+        {
+            // Prefer the plugin's batch entry point, otherwise distribute the nodes across the worker threads
+            if ((ufh_server->*batch_fence)(
+                batch->nodename_list, batch->nodename_length_list, batch->node_count,
+                batch->result_list, request->secret
+            ))
             {
-                client->nodename = client->value_buffer;
+                batch_reply(request);
             }
             else
-            if (client->key_buffer == protocol::SECRET)
             {
-                client->secret = client->value_buffer;
+                completed = distribute_batch(fence, request);
             }
         }
+        else
+        {
+            std::cerr << ufh::LOGPFX_WARNING << "Batch fence request without node names from client with "
+                "socket_fd = " << request->client->socket_fd << std::endl;
+            request->current_phase = NetRequest::Phase::CANCELED;
+        }
+    }
+    catch (std::bad_alloc&)
+    {
+        std::cerr << ufh::LOGPFX_ERROR << "Batch fence request failed: Out of memory, client socket_fd = " <<
+            request->client->socket_fd << std::endl;
+        request->current_phase = NetRequest::Phase::CANCELED;
+    }
 
-        client->clear_io_buffer();
-        client->header.clear();
+    if (completed && request->batch != nullptr)
+    {
+        request->batch->clear();
+        batch_pool.deallocate(request->batch);
+        request->batch = nullptr;
+    }
+    return completed;
+}
 
-        if (client->nodename.length() > 0)
+// Distributes the nodes of a batch fence request across the worker threads
+// Returns false if the request is completed by another worker thread
+bool ServerConnector::distribute_batch(const Server::fence_action_method fence, NetRequest* const request)
+{
+    FenceBatch* const batch = request->batch;
+    const size_t node_count = batch->node_count;
+    batch->fence = fence;
+    batch->pending_count.store(node_count);
+
+    // Queue node requests for all nodes except the first one, which is processed by the current
+    // worker thread, along with any nodes that can not be queued due to the lack of free node requests
+    size_t queued_count = 1;
+    while (queued_count < node_count)
+    {
+        NetRequest* node_request = nullptr;
+        try
         {
-            bool success_flag = (ufh_server->*fence)(client->nodename, client->secret);
-
-            client->header.msg_type = success_flag ?
-                static_cast<uint16_t> (protocol::MsgType::FENCE_SUCCESS) :
-                static_cast<uint16_t> (protocol::MsgType::FENCE_FAIL);
-            client->header.data_length = MsgHeader::HEADER_SIZE;
-            client->current_phase = NetClient::Phase::SEND;
-            // FIXME: For debugging, disconnect after replying; should probably go back to RECV for production release
-            client->next_phase = NetClient::Phase::CANCELED;
-            client->io_state = NetClient::IoOp::WRITE;
+            node_request = node_pool.allocate();
+        }
+        catch (std::bad_alloc&)
+        {
+            break;
         }
+        node_request->clear();
+        node_request->client = request->client;
+        node_request->batch_request = request;
+        node_request->batch_index = queued_count;
+        node_request->current_phase = NetRequest::Phase::PENDING;
+        ++queued_count;
+
+        // Never fails, because the worker pool is sized for all requests and node requests
+        worker_pool->submit(node_request, get_priority(request->header.msg_type));
     }
-    catch (ProtocolException&)
+
+    bool completed = fence_batch_node(request, 0, request->nodename);
+    for (size_t idx = queued_count; idx < node_count; ++idx)
     {
-        std::cerr << ufh::LOGPFX_WARNING << "Protocol error, client socket_fd = " <<
-            client->socket_fd << std::endl;
-        client->current_phase = NetClient::Phase::CANCELED;
-        client->io_state = NetClient::IoOp::NOOP;
+        completed = fence_batch_node(request, idx, request->nodename);
     }
+
+    // The FenceBatch must not be accessed anymore unless the batch was completed by this thread
+    if (completed)
+    {
+        batch_reply(request);
+    }
+    return completed;
 }
 
-// @throws std::bad_alloc
-void ServerConnector::clients_init_ipv4()
+// Returns true if this was the last node of the batch fence request that had not been completed yet
+bool ServerConnector::fence_batch_node(NetRequest* const request, const size_t node_index, CharBuffer& nodename)
+{
+    FenceBatch* const batch = request->batch;
+    batch->result_list[node_index] = false;
+    if (!request->client->closed)
+    {
+        nodename = batch->nodename_list[node_index];
+        batch->result_list[node_index] = (ufh_server->*(batch->fence))(nodename, request->secret);
+    }
+    return batch->pending_count.fetch_sub(1) == 1;
+}
+
+protocol::DecodeStatus ServerConnector::decode_fence_fields(NetRequest* const request, FenceBatch* const batch) noexcept
 {
-    const size_t pool_size = client_pool.get_pool_size();
-    const size_t alloc_size = sizeof (struct sockaddr_in);
-    for (size_t idx = 0; idx < pool_size; ++idx)
+    protocol::DecodeStatus status = protocol::DecodeStatus::OK;
+    protocol::FieldView field;
+    protocol::FieldView key;
+    protocol::FieldView value;
+    size_t field_offset = request->header.get_header_size();
+    while (status == protocol::DecodeStatus::OK && field_offset < request->io_offset)
     {
-        NetClient* client = client_pool.object_at_index(idx);
-        if (client != nullptr)
+        status = protocol::decode_field(request->io_buffer, request->io_offset, field_offset, field);
+        if (status == protocol::DecodeStatus::OK)
         {
-            client->socket_domain = AF_INET;
-            client->address_mgr = std::unique_ptr<char[]>(new char[alloc_size]);
-            client->address = reinterpret_cast<struct sockaddr*> (client->address_mgr.get());
-            client->address_length = alloc_size;
+            status = protocol::decode_key_value_pair(field, key, value);
         }
-        else
+        if (status == protocol::DecodeStatus::OK)
         {
-            throw std::logic_error("client_init_ipv4(): Implementation error: client_pool returned nullptr");
+            if (key.equals(protocol::NODENAME))
+            {
+                if (batch != nullptr)
+                {
+                    status = batch->add_node(value);
+                }
+                else
+                {
+                    status = value.decode_to(request->nodename, NetRequest::NODENAME_SIZE);
+                }
+            }
+            else
+            if (key.equals(protocol::SECRET))
+            {
+                status = value.decode_to(request->secret, protocol::MAX_SECRET_LENGTH);
+            }
         }
     }
+    return status;
 }
 
-// @throws std::bad_alloc
-void ServerConnector::clients_init_ipv6()
+// Executes and releases a node request
+// Returns the batch fence request if it has been completed, otherwise nullptr
+ServerConnector::NetRequest* ServerConnector::process_batch_node(NetRequest* const node_request)
 {
-    const size_t pool_size = client_pool.get_pool_size();
-    const size_t alloc_size = sizeof (struct sockaddr_in6);
-    for (size_t idx = 0; idx < pool_size; ++idx)
+    NetRequest* const batch_request = node_request->batch_request;
+    const bool completed = fence_batch_node(batch_request, node_request->batch_index, node_request->nodename);
+
+    // Node requests are not counted as active requests of the client
+    node_request->clear();
+    node_pool.deallocate(node_request);
+
+    NetRequest* completed_request = nullptr;
+    if (completed)
+    {
+        batch_reply(batch_request);
+        completed_request = batch_request;
+    }
+    return completed_request;
+}
+
+// Constructs the reply to a completed batch fence request and releases the request's FenceBatch
+void ServerConnector::batch_reply(NetRequest* const request)
+{
+    FenceBatch* const batch = request->batch;
+    try
     {
-        NetClient* client = client_pool.object_at_index(idx);
-        if (client != nullptr)
+        request->clear_io_buffer();
+
+        request->key_buffer = protocol::RESULTS;
+        request->key_buffer.append(protocol::KEY_VALUE_SPLIT_SEQ);
+        for (size_t idx = 0; idx < batch->node_count; ++idx)
         {
-            client->socket_domain = AF_INET6;
-            client->address_mgr = std::unique_ptr<char[]>(new char[alloc_size]);
-            client->address = reinterpret_cast<struct sockaddr*> (client->address_mgr.get());
-            client->address_length = alloc_size;
+            request->key_buffer.append(batch->result_list[idx] ? protocol::RESULT_SUCCESS : protocol::RESULT_FAIL);
         }
-        else
+
+        size_t offset = request->header.get_header_size();
+        protocol::write_field(request->io_buffer, NetRequest::IO_BUFFER_SIZE, offset, request->key_buffer);
+
+        request->header.msg_type = static_cast<uint16_t> (protocol::MsgType::FENCE_BATCH_RESULT);
+        request->header.data_length = static_cast<uint16_t> (offset);
+        request->current_phase = NetRequest::Phase::SEND;
+    }
+    catch (ProtocolException&)
+    {
+        std::cerr << ufh::LOGPFX_ERROR << "Batch fence reply construction failed, client socket_fd = " <<
+            request->client->socket_fd << std::endl;
+        request->current_phase = NetRequest::Phase::CANCELED;
+    }
+    catch (RangeException&)
+    {
+        std::cerr << ufh::LOGPFX_ERROR << "Batch fence reply construction failed, client socket_fd = " <<
+            request->client->socket_fd << std::endl;
+        request->current_phase = NetRequest::Phase::CANCELED;
+    }
+
+    batch->clear();
+    batch_pool.deallocate(batch);
+    request->batch = nullptr;
+}
+
+void ServerConnector::echo_reply(NetRequest* const request) noexcept
+{
+    request->clear_io_buffer();
+    request->header.msg_type = static_cast<uint16_t> (protocol::MsgType::ECHO_REPLY);
+    request->header.data_length = static_cast<uint16_t> (request->header.get_header_size());
+    request->current_phase = NetRequest::Phase::SEND;
+}
+
+void ServerConnector::version_reply(NetRequest* const request) noexcept
+{
+    request->clear_io_buffer();
+
+    const size_t offset = request->header.get_header_size();
+    for (size_t idx = 0; idx < version_fields_length; ++idx)
+    {
+        request->io_buffer[offset + idx] = version_fields[idx];
+    }
+
+    request->header.msg_type = static_cast<uint16_t> (protocol::MsgType::VERSION_REPLY);
+    request->header.data_length = static_cast<uint16_t> (offset + version_fields_length);
+    request->current_phase = NetRequest::Phase::SEND;
+}
+
+// @throws std::bad_alloc, ProtocolException
+void ServerConnector::init_version_fields()
+{
+    // Sized so that the fields fit into a reply with a request ID
+    const size_t fields_capacity = NetRequest::IO_BUFFER_SIZE - MsgHeader::EXT_HEADER_SIZE;
+    version_fields_mgr = std::unique_ptr<char[]>(new char[fields_capacity]);
+    version_fields = version_fields_mgr.get();
+
+    std::string version_field(protocol::VERSION);
+    version_field += protocol::KEY_VALUE_SPLIT_SEQ.c_str();
+    version_field += ufh_server->get_version();
+
+    std::string version_code_field(protocol::VERSION_CODE);
+    version_code_field += protocol::KEY_VALUE_SPLIT_SEQ.c_str();
+    version_code_field += std::to_string(ufh_server->get_version_code());
+
+    size_t offset = 0;
+    protocol::write_field(version_fields, fields_capacity, offset, version_field);
+    protocol::write_field(version_fields, fields_capacity, offset, version_code_field);
+    version_fields_length = offset;
+}
+
+void ServerConnector::stats_reply(NetRequest* const request)
+{
+    try
+    {
+        request->clear_io_buffer();
+
+        // The worker pool statistics are those of the reactor shard that serves the client's connection
+        ServerStats& stats = ufh_server->get_stats();
+        const char* const counter_names[] =
+        {
+            protocol::IDLE_TIMEOUTS,
+            protocol::RECV_TIMEOUTS,
+            protocol::SEND_TIMEOUTS,
+            protocol::FENCE_COALESCED,
+            protocol::FENCE_SERIALIZED,
+            protocol::FENCE_CACHE_HITS,
+            protocol::FENCE_CACHE_MISSES,
+            protocol::WORKER_QUEUE_DEPTH,
+            protocol::WORKER_QUEUE_DEPTH_HIGH,
+            protocol::WORKER_QUEUE_DEPTH_NORMAL,
+            protocol::WORKER_QUEUE_DEPTH_LOW,
+            protocol::WORKER_AGED_TASKS,
+            protocol::WORKER_STEALS,
+            protocol::WORKER_PARK_TIME_MS,
+            protocol::WORKER_THREADS,
+            protocol::WORKER_SPAWNS,
+            protocol::WORKER_RETIREMENTS
+        };
+        const uint64_t counter_values[] =
+        {
+            stats.idle_timeouts.load(),
+            stats.recv_timeouts.load(),
+            stats.send_timeouts.load(),
+            stats.fence_coalesced.load(),
+            stats.fence_serialized.load(),
+            stats.fence_cache_hits.load(),
+            stats.fence_cache_misses.load(),
+            worker_pool->get_queue_depth(),
+            worker_pool->get_queue_depth(WorkerPool::Priority::HIGH),
+            worker_pool->get_queue_depth(WorkerPool::Priority::NORMAL),
+            worker_pool->get_queue_depth(WorkerPool::Priority::LOW),
+            worker_pool->get_aged_count(),
+            worker_pool->get_steal_count(),
+            worker_pool->get_park_time(),
+            worker_pool->get_thread_count(),
+            worker_pool->get_spawn_count(),
+            worker_pool->get_retire_count()
+        };
+
+        size_t offset = request->header.get_header_size();
+        const size_t counter_count = sizeof (counter_values) / sizeof (counter_values[0]);
+        for (size_t idx = 0; idx < counter_count; ++idx)
         {
-            throw std::logic_error("client_init_ipv6(): Implementation error: client_pool returned nullptr");
+            std::string counter_field(counter_names[idx]);
+            counter_field += protocol::KEY_VALUE_SPLIT_SEQ.c_str();
+            counter_field += std::to_string(counter_values[idx]);
+            protocol::write_field(request->io_buffer, NetRequest::IO_BUFFER_SIZE, offset, counter_field);
         }
+
+        // Number of sockets that each socket option was applied to, and the total number of failures
+        uint64_t failed_count = 0;
+        for (size_t idx = 0; idx < socket_setup::Tuning::OPTION_COUNT; ++idx)
+        {
+            const socket_setup::Tuning::Option option = static_cast<socket_setup::Tuning::Option> (idx);
+            std::string counter_field(protocol::SOCKOPT_PREFIX);
+            counter_field += socket_setup::Tuning::get_option_name(option);
+            counter_field += protocol::KEY_VALUE_SPLIT_SEQ.c_str();
+            counter_field += std::to_string(socket_tuning->get_applied_count(option));
+            protocol::write_field(request->io_buffer, NetRequest::IO_BUFFER_SIZE, offset, counter_field);
+            failed_count += socket_tuning->get_failed_count(option);
+        }
+        std::string failures_field(protocol::SOCKOPT_FAILURES);
+        failures_field += protocol::KEY_VALUE_SPLIT_SEQ.c_str();
+        failures_field += std::to_string(failed_count);
+        protocol::write_field(request->io_buffer, NetRequest::IO_BUFFER_SIZE, offset, failures_field);
+
+        request->header.msg_type = static_cast<uint16_t> (protocol::MsgType::STATS_REPLY);
+        request->header.data_length = static_cast<uint16_t> (offset);
+        request->current_phase = NetRequest::Phase::SEND;
+    }
+    catch (ProtocolException&)
+    {
+        std::cerr << ufh::LOGPFX_ERROR << "Statistics reply construction failed, client socket_fd = " <<
+            request->client->socket_fd << std::endl;
+        request->current_phase = NetRequest::Phase::CANCELED;
+    }
+    catch (std::bad_alloc&)
+    {
+        std::cerr << ufh::LOGPFX_ERROR << "Statistics reply construction failed: Out of memory, client socket_fd = " <<
+            request->client->socket_fd << std::endl;
+        request->current_phase = NetRequest::Phase::CANCELED;
     }
 }
 
 // @throws std::bad_alloc
-ServerConnector::NetClient::NetClient():
+ServerConnector::NetRequest::NetRequest():
     key_buffer(FIELD_SIZE),
-    value_buffer(FIELD_SIZE),
     nodename(NODENAME_SIZE),
     secret(protocol::MAX_SECRET_LENGTH)
 {
@@ -655,28 +1701,132 @@ ServerConnector::NetClient::NetClient():
     io_buffer = io_buffer_mgr.get();
 }
 
-ServerConnector::NetClient::~NetClient() noexcept
+ServerConnector::NetRequest::~NetRequest() noexcept
 {
 }
 
-void ServerConnector::NetClient::clear() noexcept
+void ServerConnector::NetRequest::clear() noexcept
 {
-    zero_memory(reinterpret_cast<char*> (address), static_cast<size_t> (address_length));
-    socket_fd       = sys::FD_NONE;
+    client          = nullptr;
     current_phase   = Phase::RECV;
-    next_phase      = Phase::PENDING;
-    io_state        = IoOp::NOOP;
     header.clear();
     nodename.wipe();
     secret.wipe();
     key_buffer.wipe();
-    value_buffer.wipe();
+    batch           = nullptr;
+    batch_request   = nullptr;
+    batch_index     = 0;
     clear_io_buffer();
 }
 
-void ServerConnector::NetClient::clear_io_buffer() noexcept
+void ServerConnector::NetRequest::clear_io_buffer() noexcept
 {
     io_offset = 0;
-    have_header = false;
     zero_memory(io_buffer, IO_BUFFER_SIZE);
 }
+
+// @throws std::bad_alloc
+ServerConnector::FenceBatch::FenceBatch()
+{
+    name_buffer_mgr = std::unique_ptr<char[]>(new char[NetRequest::IO_BUFFER_SIZE]);
+    name_buffer = name_buffer_mgr.get();
+
+    nodename_list_mgr = std::unique_ptr<const char*[]>(new const char*[protocol::MAX_BATCH_NODES]);
+    nodename_list = nodename_list_mgr.get();
+
+    nodename_length_list_mgr = std::unique_ptr<size_t[]>(new size_t[protocol::MAX_BATCH_NODES]);
+    nodename_length_list = nodename_length_list_mgr.get();
+
+    result_list_mgr = std::unique_ptr<bool[]>(new bool[protocol::MAX_BATCH_NODES]);
+    result_list = result_list_mgr.get();
+
+    pending_count.store(0);
+}
+
+ServerConnector::FenceBatch::~FenceBatch() noexcept
+{
+}
+
+void ServerConnector::FenceBatch::clear() noexcept
+{
+    zero_memory(name_buffer, NetRequest::IO_BUFFER_SIZE);
+    name_buffer_offset = 0;
+    node_count = 0;
+    fence = nullptr;
+    pending_count.store(0);
+}
+
+protocol::DecodeStatus ServerConnector::FenceBatch::add_node(const protocol::FieldView& nodename) noexcept
+{
+    const size_t nodename_length = nodename.length;
+    if (node_count >= protocol::MAX_BATCH_NODES || nodename_length == 0)
+    {
+        return protocol::DecodeStatus::INVALID_VALUE;
+    }
+    else
+    if (nodename_length > NetRequest::NODENAME_SIZE ||
+        nodename_length >= NetRequest::IO_BUFFER_SIZE - name_buffer_offset)
+    {
+        return protocol::DecodeStatus::VALUE_TOO_LONG;
+    }
+
+    char* const nodename_ptr = &(name_buffer[name_buffer_offset]);
+    const char* const src = nodename.data;
+    for (size_t idx = 0; idx < nodename_length; ++idx)
+    {
+        nodename_ptr[idx] = src[idx];
+    }
+    nodename_ptr[nodename_length] = '\0';
+    name_buffer_offset += nodename_length + 1;
+
+    nodename_list[node_count] = nodename_ptr;
+    nodename_length_list[node_count] = nodename_length;
+    result_list[node_count] = false;
+    ++node_count;
+    return protocol::DecodeStatus::OK;
+}
+
+ServerConnector::Listener::Listener():
+    SelectorBackend::Target(SelectorBackend::Target::Kind::LISTENER)
+{
+}
+
+ServerConnector::Listener::~Listener() noexcept
+{
+}
+
+// @throws std::bad_alloc
+ServerConnector::NetClient::NetClient():
+    SelectorBackend::Target(SelectorBackend::Target::Kind::CLIENT),
+    recv_buffer(RECV_BUFFER_SIZE)
+{
+    address_mgr = std::unique_ptr<char[]>(new char[ADDRESS_SIZE]);
+    address = reinterpret_cast<struct sockaddr*> (address_mgr.get());
+    address_length = ADDRESS_SIZE;
+    closed.store(false);
+}
+
+ServerConnector::NetClient::~NetClient() noexcept
+{
+}
+
+void ServerConnector::NetClient::clear() noexcept
+{
+    zero_memory(reinterpret_cast<char*> (address), static_cast<size_t> (address_length));
+    socket_fd       = sys::FD_NONE;
+    interest        = SelectorBackend::Interest::NONE;
+    closed.store(false);
+    recv_buffer.clear();
+    held_request    = nullptr;
+    serial_mode     = false;
+    active_count    = 0;
+    send_queue.clear();
+    send_pending    = false;
+    partial_reply   = nullptr;
+    deadline        = Deadline::NONE;
+}
+
+bool ServerConnector::NetClient::is_receiving() const noexcept
+{
+    return !closed && !serial_mode && active_count < MAX_PIPELINE_DEPTH;
+}
@@ -4,12 +4,20 @@
 #include <cstddef>
 #include <cstdint>
 #include <mutex>
+#include <atomic>
+#include <chrono>
 
 #include <CharBuffer.h>
 
 #include "Server.h"
 #include "SignalHandler.h"
-#include "GenAlloc.h"
+#include "SelectorBackend.h"
+#include "SlabAlloc.h"
+#include "MpscQueue.h"
+#include "TimerWheel.h"
+#include "RingBuffer.h"
+#include "Endpoint.h"
+#include "socket_setup.h"
 #include "MsgHeader.h"
 #include "Queue.h"
 #include "WorkerPool.h"
@@ -20,7 +28,6 @@ extern "C"
 {
     #include <sys/types.h>
     #include <sys/socket.h>
-    #include <sys/select.h>
 }
 
 class WorkerThreadInvocation;
@@ -30,60 +37,177 @@ class ServerConnector
     friend class WorkerThreadInvocation;
 
   public:
-    static const size_t MAX_CONNECTIONS;
-    static const size_t MAX_CONNECTION_BACKLOG;
-
-    // Locking order:
-    //     1. com_queue_lock
-    //     2. action_queue_lock
-    std::mutex com_queue_lock;
-    std::mutex action_queue_lock;
+    static const size_t CLIENT_SLAB_SIZE;
+    static const size_t REQUEST_SLAB_SIZE;
+    static const size_t BATCH_SLAB_SIZE;
+    static const size_t MAX_PIPELINE_DEPTH;
+    static const size_t MAX_SELECTOR_EVENTS;
+    static const int TIMER_TICK_LENGTH;
 
   private:
-    class NetClient : public Queue<NetClient>::Node
+    class NetClient;
+
+    // Deadline that applies to a client connection, depending on the state of the connection
+    enum class Deadline : uint8_t
+    {
+        // Requests are being executed, no deadline
+        NONE    = 0,
+        // Waiting for the client to send a request
+        IDLE    = 1,
+        // The client has started sending a request, but has not sent the complete request yet
+        RECV    = 2,
+        // Replies are pending, but the client does not accept the data
+        SEND    = 3
+    };
+
+    // Node list and per-node results of a batch fence request that is being executed
+    //
+    // If the fencing plugin does not provide a batch entry point, the nodes of the batch are distributed
+    // across the worker threads as node requests, and the worker thread that completes the last node
+    // completes the batch request.
+    class FenceBatch
+    {
+      public:
+        std::unique_ptr<char[]>         name_buffer_mgr;
+        std::unique_ptr<const char*[]>  nodename_list_mgr;
+        std::unique_ptr<size_t[]>       nodename_length_list_mgr;
+        std::unique_ptr<bool[]>         result_list_mgr;
+
+        // Null-terminated node names, referenced by the nodename_list
+        char*               name_buffer             = nullptr;
+        size_t              name_buffer_offset      = 0;
+        const char**        nodename_list           = nullptr;
+        size_t*             nodename_length_list    = nullptr;
+        bool*               result_list             = nullptr;
+        size_t              node_count              = 0;
+
+        // Single node fencing action, used if the nodes are distributed across the worker threads
+        Server::fence_action_method fence   = nullptr;
+        // Number of nodes with a fencing action that has not been completed yet
+        std::atomic<size_t>         pending_count;
+
+        // @throws std::bad_alloc
+        FenceBatch();
+        virtual ~FenceBatch() noexcept;
+        FenceBatch(const FenceBatch& orig) = delete;
+        FenceBatch(FenceBatch&& orig) = delete;
+        virtual FenceBatch& operator=(const FenceBatch& orig) = delete;
+        virtual FenceBatch& operator=(FenceBatch&& orig) = delete;
+        virtual void clear() noexcept;
+
+        // Copies the node name into the name_buffer
+        virtual protocol::DecodeStatus add_node(const protocol::FieldView& nodename) noexcept;
+    };
+
+    // A single request received on a client connection and its reply
+    //
+    // Requests are received by the selector, executed by the worker threads and queued
+    // on the client connection's send queue once the reply is ready. Multiple requests of the same
+    // client connection may be in progress concurrently.
+    class NetRequest :
+        public Queue<NetRequest>::Node, public MpscQueue<NetRequest>::Node, public WorkerPool::Task
     {
       public:
         static const size_t IO_BUFFER_SIZE;
         static const size_t FIELD_SIZE;
         static const size_t NODENAME_SIZE;
 
-        enum class IoOp : uint8_t
-        {
-            NOOP    = 0,
-            READ    = 1,
-            WRITE   = 2
-        };
-
         enum class Phase : uint8_t
         {
             RECV        = 0,
-            SEND        = 1,
-            PENDING     = 2,
-            EXECUTING   = 3,
-            CANCELED    = 4
+            PENDING     = 1,
+            EXECUTING   = 2,
+            SEND        = 3,
+            CANCELED    = 4,
+            // The reply was sent completely by the worker thread that executed the request
+            SENT        = 5
         };
 
-        std::unique_ptr<char[]> address_mgr;
         std::unique_ptr<char[]> io_buffer_mgr;
 
         CharBuffer          key_buffer;
-        CharBuffer          value_buffer;
 
         CharBuffer          nodename;
         CharBuffer          secret;
 
-        struct sockaddr*    address         = nullptr;
-        socklen_t           address_length  = 0;
-        int                 socket_domain   = AF_INET6;
-        int                 socket_fd       = sys::FD_NONE;
+        NetClient*          client          = nullptr;
         Phase               current_phase   = Phase::RECV;
-        Phase               next_phase      = Phase::PENDING;
-        IoOp                io_state        = IoOp::NOOP;
         MsgHeader           header;
-        bool                have_header     = false;
         size_t              io_offset       = 0;
         char*               io_buffer       = nullptr;
 
+        // Node list and results, while a batch fence request is being executed
+        FenceBatch*         batch           = nullptr;
+        // If set, this is a node request that executes the fencing action for one of the nodes
+        // of the batch fence request batch_request
+        NetRequest*         batch_request   = nullptr;
+        size_t              batch_index     = 0;
+
+        // @throws std::bad_alloc
+        NetRequest();
+        virtual ~NetRequest() noexcept;
+        NetRequest(const NetRequest& orig) = delete;
+        NetRequest(NetRequest&& orig) = default;
+        virtual NetRequest& operator=(const NetRequest& orig) = delete;
+        virtual NetRequest& operator=(NetRequest&& orig) = default;
+        virtual void clear() noexcept;
+        virtual void clear_io_buffer() noexcept;
+    };
+
+    // A client connection
+    //
+    // Open connections are members of the com_queue. A connection that is closed while some of its
+    // requests are still being executed is removed from the com_queue, and the client object
+    // is deallocated when the last of those requests completes.
+    // The client's timer is armed on the deadline_wheel for the client's current deadline.
+    class NetClient :
+        public Queue<NetClient>::Node,
+        public SelectorBackend::Target,
+        public TimerWheel::Timer
+    {
+      public:
+        static const socklen_t ADDRESS_SIZE;
+        static const size_t RECV_BUFFER_SIZE;
+
+        std::unique_ptr<char[]> address_mgr;
+
+        struct sockaddr*    address         = nullptr;
+        socklen_t           address_length  = 0;
+        int                 socket_domain   = AF_INET6;
+        int                 socket_fd       = sys::FD_NONE;
+        // Interest currently registered with the selector
+        SelectorBackend::Interest   interest    = SelectorBackend::Interest::NONE;
+        // Set when the connection is closed; read by worker threads
+        std::atomic<bool>   closed;
+
+        // Data received from the client that has not been processed yet, which is either a partially
+        // received request, or requests that are held back while the client is not receiving
+        RingBuffer          recv_buffer;
+        // Request without a request ID that has been received, but must not be executed before
+        // the replies to all other requests have been sent
+        NetRequest*         held_request    = nullptr;
+        // Set while a request without a request ID is in progress, to stop receiving further requests,
+        // so that the reply can be matched to the request by the client
+        bool                serial_mode     = false;
+        // Number of requests that are pending, executing or queued for sending
+        size_t              active_count    = 0;
+        // Replies that are ready to be sent
+        Queue<NetRequest>   send_queue;
+
+        // Serializes writing to the socket between the selector thread and worker threads that send
+        // replies directly, and prevents closing the socket while a worker thread is sending a reply
+        std::mutex          send_lock;
+        // Set while replies are queued on the send_queue or a reply has been sent partially, protected by
+        // the send_lock; worker threads send replies directly only while it is cleared, so that the data
+        // of different replies is never interleaved
+        bool                send_pending    = false;
+        // Reply that was sent partially by a worker thread and has not been queued on the send_queue
+        // by the selector thread yet, protected by the send_lock
+        NetRequest*         partial_reply   = nullptr;
+
+        Deadline            deadline        = Deadline::NONE;
+
+        // @throws std::bad_alloc
         NetClient();
         virtual ~NetClient() noexcept;
         NetClient(const NetClient& orig) = delete;
@@ -91,42 +215,134 @@ class ServerConnector
         virtual NetClient& operator=(const NetClient& orig) = delete;
         virtual NetClient& operator=(NetClient&& orig) = default;
         virtual void clear() noexcept;
-        virtual void clear_io_buffer() noexcept;
+
+        // Indicates whether the connection can accept another request
+        virtual bool is_receiving() const noexcept;
     };
 
-    using ClientAlloc = GenAlloc<NetClient>;
+    // A server socket that accepts client connections
+    //
+    // A connector has a listener for each of the endpoints that the server listens on, e.g. for
+    // IPv4 and IPv6 addresses on several networks and for unix domain sockets for clients that run
+    // on the same host. All listeners are served by the same selector loop and share the client pool.
+    // Client objects store addresses of any family.
+    class Listener : public SelectorBackend::Target
+    {
+      public:
+        std::unique_ptr<char[]> address_mgr;
 
-    Server* ufh_server;
-    SignalHandler* stop_signal;
+        struct sockaddr*    address         = nullptr;
+        socklen_t           address_length  = 0;
+        int                 socket_domain   = AF_INET6;
+        int                 socket_fd       = sys::FD_NONE;
+        // Set once the socket is bound, so that the path of a unix domain socket is removed on cleanup
+        bool                bound           = false;
+        // Set while accepting connections is enabled on the selector
+        bool                active          = false;
+        // Set by the selector loop if connections are pending
+        bool                accept_pending  = false;
+
+        Listener();
+        virtual ~Listener() noexcept;
+        Listener(const Listener& orig) = delete;
+        Listener(Listener&& orig) = delete;
+        virtual Listener& operator=(const Listener& orig) = delete;
+        virtual Listener& operator=(Listener&& orig) = delete;
+    };
 
-    std::unique_ptr<char[]> address_mgr;
+    using ClientAlloc = SlabAlloc<NetClient>;
+    using RequestAlloc = SlabAlloc<NetRequest>;
+    using BatchAlloc = SlabAlloc<FenceBatch>;
 
-    struct sockaddr*    address         = nullptr;
-    socklen_t           address_length  = 0;
-    int                 socket_domain   = AF_INET6;
-    int                 socket_fd       = sys::FD_NONE;
-    fd_set              *read_fd_set    = nullptr;
-    fd_set              *write_fd_set   = nullptr;
-    ClientAlloc         client_pool     = ClientAlloc(MAX_CONNECTIONS);
+    Server* ufh_server;
+    SignalHandler* stop_signal;
+    // Socket options of TCP sockets, owned by the server
+    socket_setup::Tuning* socket_tuning;
+
+    std::unique_ptr<Listener[]> listener_list_mgr;
+    Listener*           listener_list   = nullptr;
+    size_t              listener_count  = 0;
+    // Connections on unix domain sockets are accepted from the superuser, from the server's
+    // effective user and from the peer_uid only
+    uid_t               peer_uid        = 0;
+    // Set if any of the listeners is an IPv4 listener
+    bool                have_ipv4_listeners = false;
+    bool                reuse_port      = false;
+    size_t              max_connections = 0;
+    size_t              backlog_length  = 0;
+    // Deadline timeouts in timer ticks, zero if the deadline is not enforced
+    uint64_t            idle_timeout    = 0;
+    uint64_t            recv_timeout    = 0;
+    uint64_t            send_timeout    = 0;
+    // Deadlines of all client connections
+    // Tick zero of the wheel is the time when the connector was created
+    TimerWheel          deadline_wheel;
+    std::chrono::steady_clock::time_point   timer_base;
+    ClientAlloc         client_pool;
+    RequestAlloc        request_pool;
+    // Node requests of batch fence requests, sized for one node request per connection
+    RequestAlloc        node_pool;
+    BatchAlloc          batch_pool;
+    // Worker pool that executes requests, set by run()
+    WorkerPool*         worker_pool         = nullptr;
+
+    // Wakeup eventfd of the selector
+    int                 selector_trigger    = sys::FD_NONE;
+    // Prevents closing the selector_trigger while a worker thread is writing to it
+    std::mutex          trigger_lock;
+    // Set while a wakeup is pending on the selector_trigger, so that further wakeups can be skipped
+    std::atomic<bool>   wakeup_pending;
+
+    // Client connections, the com_queue and the clients' state are owned by the selector thread,
+    // worker threads hand completed requests back to the selector thread through the completion_queue
+    Queue<NetClient>        com_queue;
+    MpscQueue<NetRequest>   completion_queue;
 
-    int                 selector_trigger[2];
+    std::unique_ptr<SelectorBackend>            selector;
+    std::unique_ptr<SelectorBackend::Event[]>   selector_events_mgr;
+    SelectorBackend::Event*                     selector_events     = nullptr;
+    SelectorBackend::Target                     wakeup_target       =
+        SelectorBackend::Target(SelectorBackend::Target::Kind::WAKEUP);
 
-    Queue<NetClient>        com_queue;
-    Queue<NetClient>        action_queue;
+    // Header of the next request in a client's recv_buffer, used by process_received_frames()
+    std::unique_ptr<char[]> frame_header_mgr;
+    char*                   frame_header_data   = nullptr;
+    MsgHeader               frame_header;
 
-    std::unique_ptr<fd_set> read_fd_set_mgr;
-    std::unique_ptr<fd_set> write_fd_set_mgr;
+    // Fields of the version reply, serialized once, since they do not change while the server is running
+    std::unique_ptr<char[]> version_fields_mgr;
+    char*                   version_fields          = nullptr;
+    size_t                  version_fields_length   = 0;
 
     std::unique_ptr<WorkerThreadInvocation> invocation_obj;
 
   public:
-    // @throws std::bad_alloc, InetException
+    // If reuse_port is set, the server socket is bound with SO_REUSEPORT, so that multiple
+    // ServerConnector shards can listen on the same address and port
+    // The client pool grows in slabs of CLIENT_SLAB_SIZE clients up to max_connections_limit clients
+    // Connections that are waiting for a request for more than idle_timeout_secs seconds, that do not
+    // complete a request within recv_timeout_secs seconds after starting to send it, or that do not accept
+    // any reply data for more than send_timeout_secs seconds are closed; a timeout of zero disables the
+    // respective deadline
+    // The connector listens on each of the endpoints of the endpoint_list, except for unix domain sockets,
+    // which are skipped unless local_listeners_flag is set, since only one socket can be bound to the path
+    // of a unix domain socket. Connections on unix domain sockets are authenticated by the peer credentials
+    // of the connecting process, see peer_uid.
+    // @throws std::bad_alloc, InetException, ProtocolException
     ServerConnector(
         Server& server_ref,
         SignalHandler& stop_signal_ref,
-        const CharBuffer& protocol_string,
-        const CharBuffer& ip_string,
-        const CharBuffer& port_string
+        const Endpoint* endpoint_list,
+        size_t endpoint_count,
+        bool local_listeners_flag,
+        uid_t allowed_peer_uid,
+        SelectorBackend::Type selector_type,
+        bool reuse_port_flag,
+        size_t max_connections_limit,
+        size_t connection_backlog,
+        size_t idle_timeout_secs,
+        size_t recv_timeout_secs,
+        size_t send_timeout_secs
     );
     virtual ~ServerConnector() noexcept;
     ServerConnector(const ServerConnector& orig) = delete;
@@ -137,40 +353,205 @@ class ServerConnector
     // @throws InetException, OsException
     virtual void run(WorkerPool& thread_pool);
 
-    // Caller must have locked the client_queue_lock
-    virtual void close_connection(NetClient* const current_client);
+    // Checks that none of the addresses and ports of the connector's IPv4 and IPv6 listeners is in use
+    //
+    // Sockets bound with SO_REUSEPORT share the incoming connections with any other socket of the same
+    // user that is bound to the same address and port with SO_REUSEPORT. If the connectors of multiple
+    // reactor shards use SO_REUSEPORT, this must be called for one of the connectors before any
+    // connector is started, so that the server does not silently share its connections with another process.
+    // @throws InetException
+    virtual void check_listener_addresses();
 
     virtual WorkerPool::WorkerPoolExecutor* get_worker_thread_invocation() noexcept;
 
+    virtual size_t get_max_connections() const noexcept;
+
+    // Maximum number of requests and node requests that can be waiting for a worker thread at any time
+    virtual size_t get_max_pending_requests() const noexcept;
+
   private:
-    // Caller must have locked the action_queue_lock
-    void process_action_queue() noexcept;
+    // Executes a request on a worker thread
+    void execute_task(WorkerPool::Task* task) noexcept;
 
     // @throws InetException, OsException
     void init();
 
+    // @throws InetException, OsException
+    void init_listener(Listener& listener);
+
     // @throws InetException, OsException
     void selector_loop(WorkerPool& thread_pool);
 
-    // Caller must hold the com_queue_lock to avoid concurrent close of the selector_trigger pipe
-    // by the cleanup() method
+    // May be called by any thread
+    // Wakeups are coalesced, only the first wakeup after the selector cleared the selector_trigger
+    // writes to the eventfd
     void wakeup_selector();
 
     void cleanup();
 
-    void accept_connection();
-    bool receive_message(NetClient* const current_client);
-    bool send_message(NetClient* const current_client);
-
+    // Enables or disables accepting connections depending on the availability of client objects
+    // @throws OsException
+    void update_listener_interest();
+
+    // Must be called by the selector thread
+    // @throws OsException
+    void update_client_interest(NetClient* client);
+
+    // Must be called by the selector thread
+    // @throws OsException
+    void process_client_io(NetClient* client, const SelectorBackend::Event& ready_event, WorkerPool& thread_pool);
+
+    // Clears the pending wakeup and resets the selector_trigger eventfd
+    void clear_selector_trigger() noexcept;
+
+    uint64_t get_current_tick() const noexcept;
+
+    // Arms the client's timer for the deadline that applies to the client's current state,
+    // unless the deadline is already armed
+    // If io_progress is set, because data was received from or sent to the client, a receive or send
+    // deadline is rearmed even if it is already armed; an idle deadline is only armed when it begins
+    // Must be called by the selector thread
+    void update_client_deadline(NetClient* client, bool io_progress);
+
+    // (Re)arms the client's timer for the specified deadline
+    // Must be called by the selector thread
+    void set_client_deadline(NetClient* client, Deadline deadline);
+
+    // Closes connections with an expired deadline
+    // Must be called by the selector thread
+    void process_expired_deadlines();
+
+    // Returns the selector wait timeout in milliseconds for the next deadline expiry
+    // Must be called by the selector thread
+    int get_deadline_wait_timeout() const noexcept;
+
+    // Accepts pending connections until there are no more pending connections or no more free client objects
+    void accept_connections();
+
+    // Returns true if more connections may be pending on the listener
+    bool accept_connection(Listener& listener);
+
+    // Checks whether the peer of a connection on a unix domain socket is allowed to connect
+    bool check_peer_credentials(int socket_fd);
+
+    // Closes the client's socket and releases all requests that are not being executed
+    // The client object is released if no requests are being executed
+    // Must be called by the selector thread
+    // The client must not be a member of any queue
+    void close_connection(NetClient* client);
+
+    // Releases a request that is not a member of any queue
+    // If the request was the last active request of a closed client, the client object is released
+    // Must be called by the selector thread
+    void release_request(NetRequest* request);
+
+    // Receives as much data as is available and processes all completely received requests
+    // Sets io_progress if any data was received
+    // Must be called by the selector thread
+    // Returns false if the connection was closed
+    bool receive_request(NetClient* client, WorkerPool& thread_pool, bool& io_progress);
+
+    // Extracts completely received requests from the client's recv_buffer and dispatches them,
+    // until the client stops receiving or there are no more complete requests
+    // Must be called by the selector thread
+    // Returns false if the connection was closed
+    bool process_received_frames(NetClient* client, WorkerPool& thread_pool);
+
+    // Sets io_progress if any data was sent
+    // Must be called by the selector thread
+    // Returns false if the connection was closed
+    bool send_replies(NetClient* client, WorkerPool& thread_pool, bool& io_progress);
+
+    // Answers a completely received request directly if it does not involve the fencing plugin, otherwise
+    // queues the request for execution by a worker thread
+    // Must be called by the selector thread
+    void dispatch_request(NetRequest* request, WorkerPool& thread_pool);
+
+    // Constructs the reply to requests of message types that never block, e.g. ECHO_REQUEST
+    // Must be called by the selector thread
+    // Returns false if the request must be executed by a worker thread
+    bool answer_inline(NetRequest* request) noexcept;
+
+    // Returns the priority level at which the worker threads execute requests of the specified message type
+    // Fencing actions that take nodes out of service precede fencing actions that bring nodes back into
+    // service, which precede all other requests
+    static WorkerPool::Priority get_priority(uint16_t msg_type) noexcept;
+
+    // Processes the requests on the completion_queue
+    // Must be called by the selector thread
+    // @throws OsException
+    void process_completions();
+
+    // Queues the reply to a request for sending to the client
+    // Must be called by the selector thread
+    // @throws OsException
+    void complete_request(NetRequest* request);
+
+    // Serializes the reply to a request and adds it to the client's send_queue, without updating
+    // the client's selector interest and deadline
+    // Must be called by the selector thread
+    void queue_reply(NetRequest* request) noexcept;
+
+    // Serializes the header of the reply to a request
+    void prepare_reply(NetRequest* request) noexcept;
+
+    // Attempts to send the reply to a request with a single non-blocking system call, so that the reply
+    // does not have to wait for the selector thread
+    // If the reply is sent completely, the request's phase is changed to SENT. If the reply can not
+    // be sent, or is sent partially, the selector thread sends the rest of the reply.
+    // Must be called by the worker thread that executed the request
+    void send_reply_direct(NetRequest* request) noexcept;
+
+    // Releases a request whose reply has been sent completely
+    // Must be called by the selector thread
+    void finish_reply(NetRequest* request);
+
+    // Starts a held request once all other requests of the client have been completed
+    // Must be called by the selector thread
+    void start_held_request(NetClient* client, WorkerPool& thread_pool);
+
+    // Returns false if the request is a batch fence request that is completed by another worker thread
     // @throws ProtocolException
-    void process_client_message(NetClient* client);
+    bool process_request(NetRequest* request);
+
+    void fence_action(Server::fence_action_method fence, NetRequest* request);
+
+    // Returns false if the request is completed by another worker thread
+    bool fence_batch_action(
+        Server::fence_action_method fence,
+        Server::fence_batch_method batch_fence,
+        NetRequest* request
+    );
+
+    // Distributes the nodes of a batch fence request across the worker threads
+    // Returns false if the request is completed by another worker thread
+    bool distribute_batch(Server::fence_action_method fence, NetRequest* request);
+
+    // Executes the fencing action for one node of a batch fence request, unless the client's connection
+    // has been closed
+    // Returns true if this was the last node of the batch fence request that had not been completed yet
+    bool fence_batch_node(NetRequest* request, size_t node_index, CharBuffer& nodename);
+
+    // Decodes the fields of a fence request without copying them, except for the values that must
+    // remain valid after the io_buffer is cleared: The secret is copied into the request's secret buffer,
+    // node names are added to the batch, or copied into the request's nodename buffer if batch is nullptr
+    protocol::DecodeStatus decode_fence_fields(NetRequest* request, FenceBatch* batch) noexcept;
+
+    // Executes and releases a node request
+    // Returns the batch fence request if it has been completed, otherwise nullptr
+    NetRequest* process_batch_node(NetRequest* node_request);
+
+    // Constructs the reply to a completed batch fence request and releases the request's FenceBatch
+    void batch_reply(NetRequest* request);
+
+    void echo_reply(NetRequest* request) noexcept;
+
+    void version_reply(NetRequest* request) noexcept;
 
-    void fence_action(Server::fence_action_method fence, NetClient* client);
+    // @throws std::bad_alloc, ProtocolException
+    void init_version_fields();
 
-    // @throws std::bad_alloc
-    void clients_init_ipv4();
-    // @throws std::bad_alloc
-    void clients_init_ipv6();
+    void stats_reply(NetRequest* request);
 };
 
 #endif /* SERVERCONNECTOR_H */
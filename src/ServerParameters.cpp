@@ -1,18 +1,82 @@
 #include "ServerParameters.h"
 
 #include <cstddef>
+#include <cstdint>
+#include <string>
+#include <algorithm>
+#include <fstream>
 #include <RangeException.h>
+#include <dsaext.h>
+#include <integerparse.h>
 #include "server_exceptions.h"
 #include "Shared.h"
 
+extern "C"
+{
+    #include <unistd.h>
+    #include <sched.h>
+}
+
+// CPU quota of the cgroup, cgroup v2 and cgroup v1
+static const char* const CGROUP_CPU_MAX_PATH        = "/sys/fs/cgroup/cpu.max";
+static const char* const CGROUP_CFS_QUOTA_PATH      = "/sys/fs/cgroup/cpu/cpu.cfs_quota_us";
+static const char* const CGROUP_CFS_PERIOD_PATH     = "/sys/fs/cgroup/cpu/cpu.cfs_period_us";
+
 // Should allow enough space for the parameter key, the split character and the maximum length
 // of any of the parameter values
 const size_t ServerParameters::MAX_PARAMETER_SIZE = 1100;
 
-const char* const ServerParameters::KEY_PROTOCOL       = "protocol";
-const char* const ServerParameters::KEY_BIND_ADDRESS   = "bind_address";
-const char* const ServerParameters::KEY_TCP_PORT       = "tcp_port";
-const char* const ServerParameters::KEY_FENCE_MODULE   = "fence_module";
+// Must not exceed the number of wakeup file descriptors supported by the SignalHandler
+const size_t ServerParameters::MAX_SHARD_COUNT = 64;
+
+const size_t ServerParameters::DFLT_MAX_CONNECTIONS     = 24;
+const size_t ServerParameters::MAX_MAX_CONNECTIONS      = 65535;
+const size_t ServerParameters::DFLT_CONNECTION_BACKLOG  = 24;
+const size_t ServerParameters::MAX_CONNECTION_BACKLOG   = 65535;
+const size_t ServerParameters::DFLT_IDLE_TIMEOUT        = 60;
+const size_t ServerParameters::MAX_IDLE_TIMEOUT         = 86400;
+const size_t ServerParameters::DFLT_RECV_TIMEOUT        = 10;
+const size_t ServerParameters::DFLT_SEND_TIMEOUT        = 10;
+const size_t ServerParameters::MAX_IO_TIMEOUT           = 86400;
+const size_t ServerParameters::MAX_MAX_WORKERS          = 4096;
+const size_t ServerParameters::DFLT_WORKER_IDLE_TIMEOUT = 60;
+const size_t ServerParameters::MAX_WORKER_IDLE_TIMEOUT  = 86400;
+const size_t ServerParameters::DFLT_FENCE_CACHE_TTL     = 0;
+const size_t ServerParameters::MAX_FENCE_CACHE_TTL      = 3600;
+// (uid_t) -1 is not a valid user ID
+const size_t ServerParameters::MAX_PEER_UID             = 0xFFFFFFFE;
+const size_t ServerParameters::MAX_ENDPOINTS            = 16;
+const char ServerParameters::ENDPOINT_SPLIT_CHAR        = ',';
+const char ServerParameters::ENDPOINT_FIELD_SPLIT_CHAR  = ':';
+
+const char* const ServerParameters::KEY_PROTOCOL         = "protocol";
+const char* const ServerParameters::KEY_BIND_ADDRESS     = "bind_address";
+const char* const ServerParameters::KEY_TCP_PORT         = "tcp_port";
+const char* const ServerParameters::KEY_FENCE_MODULE     = "fence_module";
+const char* const ServerParameters::KEY_SELECTOR         = "selector";
+const char* const ServerParameters::KEY_SHARDS           = "shards";
+const char* const ServerParameters::KEY_MAX_CONNECTIONS  = "max_connections";
+const char* const ServerParameters::KEY_BACKLOG          = "backlog";
+const char* const ServerParameters::KEY_IDLE_TIMEOUT     = "idle_timeout";
+const char* const ServerParameters::KEY_RECV_TIMEOUT     = "recv_timeout";
+const char* const ServerParameters::KEY_SEND_TIMEOUT     = "send_timeout";
+const char* const ServerParameters::KEY_MIN_WORKERS      = "min_workers";
+const char* const ServerParameters::KEY_MAX_WORKERS      = "max_workers";
+const char* const ServerParameters::KEY_WORKER_IDLE_TIMEOUT = "worker_idle_timeout";
+const char* const ServerParameters::KEY_FENCE_CACHE_TTL  = "fence_cache_ttl";
+const char* const ServerParameters::KEY_LOCAL_SOCKET     = "local_socket";
+const char* const ServerParameters::KEY_PEER_UID         = "peer_uid";
+const char* const ServerParameters::KEY_ENDPOINTS        = "endpoints";
+const char* const ServerParameters::KEY_TCP_NODELAY      = "tcp_nodelay";
+const char* const ServerParameters::KEY_TCP_QUICKACK     = "tcp_quickack";
+const char* const ServerParameters::KEY_TCP_DEFER_ACCEPT = "tcp_defer_accept";
+const char* const ServerParameters::KEY_TCP_FASTOPEN     = "tcp_fastopen";
+const char* const ServerParameters::KEY_SO_RCVBUF        = "so_rcvbuf";
+const char* const ServerParameters::KEY_SO_SNDBUF        = "so_sndbuf";
+const char* const ServerParameters::KEY_TCP_KEEPIDLE     = "tcp_keepidle";
+const char* const ServerParameters::KEY_TCP_KEEPINTVL    = "tcp_keepintvl";
+const char* const ServerParameters::KEY_TCP_KEEPCNT      = "tcp_keepcnt";
+const char* const ServerParameters::KEY_TCP_USER_TIMEOUT = "tcp_user_timeout";
 
 const CharBuffer ServerParameters::OPT_PREFIX("--");
 
@@ -32,10 +96,33 @@ void ServerParameters::initialize()
     add_entry(KEY_BIND_ADDRESS, constraints::IP_ADDR_PARAM_SIZE);
     add_entry(KEY_TCP_PORT, constraints::PORT_PARAM_SIZE);
     add_entry(KEY_FENCE_MODULE, constraints::MODULE_PARAM_SIZE);
+    add_entry(KEY_SELECTOR, constraints::SELECTOR_PARAM_SIZE);
+    add_entry(KEY_SHARDS, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_MAX_CONNECTIONS, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_BACKLOG, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_IDLE_TIMEOUT, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_RECV_TIMEOUT, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_SEND_TIMEOUT, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_MIN_WORKERS, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_MAX_WORKERS, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_WORKER_IDLE_TIMEOUT, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_FENCE_CACHE_TTL, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_LOCAL_SOCKET, constraints::IP_ADDR_PARAM_SIZE);
+    add_entry(KEY_PEER_UID, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_ENDPOINTS, constraints::ENDPOINTS_PARAM_SIZE);
+    add_entry(KEY_TCP_NODELAY, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_QUICKACK, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_DEFER_ACCEPT, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_FASTOPEN, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_SO_RCVBUF, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_SO_SNDBUF, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_KEEPIDLE, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_KEEPINTVL, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_KEEPCNT, constraints::COUNT_PARAM_SIZE);
+    add_entry(KEY_TCP_USER_TIMEOUT, constraints::COUNT_PARAM_SIZE);
 
-    mark_required(KEY_PROTOCOL);
-    mark_required(KEY_BIND_ADDRESS);
-    mark_required(KEY_TCP_PORT);
+    // The protocol, bind_address and tcp_port parameters are required depending on the protocol
+    // and on the endpoints parameter, see Server::run
     mark_required(KEY_FENCE_MODULE);
 }
 
@@ -63,3 +150,332 @@ void ServerParameters::read_parameters(const int argc, const char* const argv[])
         throw Arguments::ArgumentsException(error_msg);
     }
 }
+
+// @throws std::bad_alloc, ArgumentsException
+SelectorBackend::Type ServerParameters::get_selector_type()
+{
+    SelectorBackend::Type selector_type = SelectorBackend::Type::EPOLL;
+    const CharBuffer& selector = get_value(KEY_SELECTOR);
+    if (selector.length() > 0)
+    {
+        if (selector == keyword::SELECTOR_EPOLL)
+        {
+            selector_type = SelectorBackend::Type::EPOLL;
+        }
+        else
+        if (selector == keyword::SELECTOR_SELECT)
+        {
+            selector_type = SelectorBackend::Type::SELECT;
+        }
+        else
+        {
+            std::string error_msg("Invalid selector backend \"");
+            error_msg += selector.c_str();
+            error_msg += "\", valid selector backends are ";
+            error_msg += keyword::SELECTOR_EPOLL;
+            error_msg += ", ";
+            error_msg += keyword::SELECTOR_SELECT;
+            throw Arguments::ArgumentsException(error_msg);
+        }
+    }
+    return selector_type;
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_shard_count()
+{
+    const size_t dflt_shard_count = std::min(get_cpu_count(), MAX_SHARD_COUNT);
+    const size_t shard_count = get_count_value(KEY_SHARDS, dflt_shard_count, 1, MAX_SHARD_COUNT);
+    // Each reactor shard accepts at least one connection
+    return std::min(shard_count, get_total_connections());
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_max_connections(const size_t shard_count)
+{
+    return divide_across_shards(get_total_connections(), shard_count);
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_connection_backlog()
+{
+    return get_count_value(KEY_BACKLOG, DFLT_CONNECTION_BACKLOG, 1, MAX_CONNECTION_BACKLOG);
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_idle_timeout()
+{
+    return get_count_value(KEY_IDLE_TIMEOUT, DFLT_IDLE_TIMEOUT, 0, MAX_IDLE_TIMEOUT);
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_recv_timeout()
+{
+    return get_count_value(KEY_RECV_TIMEOUT, DFLT_RECV_TIMEOUT, 0, MAX_IO_TIMEOUT);
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_send_timeout()
+{
+    return get_count_value(KEY_SEND_TIMEOUT, DFLT_SEND_TIMEOUT, 0, MAX_IO_TIMEOUT);
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_min_workers(const size_t shard_count)
+{
+    const size_t dflt_min_workers = std::min(get_cpu_count(), MAX_MAX_WORKERS);
+    const size_t min_workers = get_count_value(KEY_MIN_WORKERS, dflt_min_workers, 1, MAX_MAX_WORKERS);
+    return divide_across_shards(min_workers, shard_count);
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_max_workers(const size_t shard_count)
+{
+    const size_t dflt_max_workers = std::min(get_total_connections(), MAX_MAX_WORKERS);
+    const size_t max_workers = get_count_value(KEY_MAX_WORKERS, dflt_max_workers, 1, MAX_MAX_WORKERS);
+    return divide_across_shards(max_workers, shard_count);
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_worker_idle_timeout()
+{
+    return get_count_value(KEY_WORKER_IDLE_TIMEOUT, DFLT_WORKER_IDLE_TIMEOUT, 1, MAX_WORKER_IDLE_TIMEOUT);
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_fence_cache_ttl()
+{
+    return get_count_value(KEY_FENCE_CACHE_TTL, DFLT_FENCE_CACHE_TTL, 0, MAX_FENCE_CACHE_TTL);
+}
+
+// @throws std::bad_alloc, ArgumentsException
+uid_t ServerParameters::get_peer_uid()
+{
+    return static_cast<uid_t> (get_count_value(KEY_PEER_UID, static_cast<size_t> (geteuid()), 0, MAX_PEER_UID));
+}
+
+// @throws std::bad_alloc, ArgumentsException
+std::unique_ptr<Endpoint[]> ServerParameters::get_endpoint_list(size_t& endpoint_count)
+{
+    std::unique_ptr<Endpoint[]> endpoint_list_mgr(new Endpoint[MAX_ENDPOINTS]);
+    Endpoint* const endpoint_list = endpoint_list_mgr.get();
+    endpoint_count = 0;
+
+    const CharBuffer& protocol = get_value(KEY_PROTOCOL);
+    if (protocol.length() > 0)
+    {
+        Endpoint& endpoint = endpoint_list[endpoint_count];
+        endpoint.protocol = protocol;
+        endpoint.address = get_value(KEY_BIND_ADDRESS);
+        endpoint.port = get_value(KEY_TCP_PORT);
+        ++endpoint_count;
+    }
+
+    const CharBuffer& local_socket = get_value(KEY_LOCAL_SOCKET);
+    if (local_socket.length() > 0)
+    {
+        Endpoint& endpoint = endpoint_list[endpoint_count];
+        endpoint.protocol = keyword::PROTO_UNIX;
+        endpoint.address = local_socket;
+        ++endpoint_count;
+    }
+
+    const CharBuffer& endpoints = get_value(KEY_ENDPOINTS);
+    const char* const endpoints_data = endpoints.c_str();
+    const size_t endpoints_length = endpoints.length();
+    CharBuffer entry(constraints::ENDPOINTS_PARAM_SIZE);
+    size_t entry_start = 0;
+    for (size_t idx = 0; idx <= endpoints_length; ++idx)
+    {
+        if (idx == endpoints_length || endpoints_data[idx] == ENDPOINT_SPLIT_CHAR)
+        {
+            // Skip empty entries
+            if (idx > entry_start)
+            {
+                if (endpoint_count >= MAX_ENDPOINTS)
+                {
+                    std::string error_msg("The server can not listen on more than ");
+                    error_msg += std::to_string(MAX_ENDPOINTS);
+                    error_msg += " endpoints";
+                    throw Arguments::ArgumentsException(error_msg);
+                }
+                entry.substring_from(endpoints, entry_start, idx);
+                parse_endpoint(entry, endpoint_list[endpoint_count]);
+                ++endpoint_count;
+            }
+            entry_start = idx + 1;
+        }
+    }
+
+    if (endpoint_count == 0)
+    {
+        throw Arguments::ArgumentsException("No endpoints selected for the server to listen on");
+    }
+    return endpoint_list_mgr;
+}
+
+size_t ServerParameters::get_cpu_count() noexcept
+{
+    size_t cpu_count = 1;
+    const long online_count = sysconf(_SC_NPROCESSORS_ONLN);
+    if (online_count > 1)
+    {
+        cpu_count = static_cast<size_t> (online_count);
+    }
+
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof (cpu_set), &cpu_set) == 0)
+    {
+        const int affinity_count = CPU_COUNT(&cpu_set);
+        if (affinity_count >= 1)
+        {
+            cpu_count = std::min(cpu_count, static_cast<size_t> (affinity_count));
+        }
+    }
+
+    // The quota is the CPU time that the cgroup may use per period; a quota of "max" (cgroup v2)
+    // or -1 (cgroup v1) means that there is no quota
+    long long quota = -1;
+    long long period = 0;
+    try
+    {
+        std::ifstream cpu_max(CGROUP_CPU_MAX_PATH);
+        if (cpu_max.is_open())
+        {
+            std::string quota_text;
+            if (cpu_max >> quota_text >> period && quota_text != "max")
+            {
+                quota = std::stoll(quota_text);
+            }
+        }
+        else
+        {
+            std::ifstream cfs_quota(CGROUP_CFS_QUOTA_PATH);
+            std::ifstream cfs_period(CGROUP_CFS_PERIOD_PATH);
+            if (!(cfs_quota >> quota && cfs_period >> period))
+            {
+                quota = -1;
+            }
+        }
+    }
+    catch (std::exception&)
+    {
+        // Unreadable quota, handled the same way as no quota
+        quota = -1;
+    }
+
+    if (quota > 0 && period > 0)
+    {
+        // Partial CPUs are rounded up
+        const size_t quota_count = static_cast<size_t> ((quota + period - 1) / period);
+        cpu_count = std::max(std::min(cpu_count, quota_count), static_cast<size_t> (1));
+    }
+    return cpu_count;
+}
+
+// @throws std::bad_alloc, ArgumentsException
+size_t ServerParameters::get_total_connections()
+{
+    return get_count_value(KEY_MAX_CONNECTIONS, DFLT_MAX_CONNECTIONS, 1, MAX_MAX_CONNECTIONS);
+}
+
+size_t ServerParameters::divide_across_shards(const size_t total, const size_t shard_count) noexcept
+{
+    return std::max(total / shard_count, static_cast<size_t> (1));
+}
+
+// @throws std::bad_alloc, ArgumentsException
+void ServerParameters::parse_endpoint(const CharBuffer& entry, Endpoint& endpoint)
+{
+    const char* const entry_data = entry.c_str();
+    const size_t entry_length = entry.length();
+
+    // The protocol ends at the first split character, the port starts after the last split character,
+    // so that IPv6 addresses may contain the split character
+    const size_t protocol_end = entry.index_of(ENDPOINT_FIELD_SPLIT_CHAR);
+    size_t address_end = entry_length;
+    for (size_t idx = entry_length; idx > 0; --idx)
+    {
+        if (entry_data[idx - 1] == ENDPOINT_FIELD_SPLIT_CHAR)
+        {
+            address_end = idx - 1;
+            break;
+        }
+    }
+
+    bool valid_flag = false;
+    try
+    {
+        if (protocol_end != CharBuffer::NPOS && protocol_end > 0)
+        {
+            endpoint.protocol.substring_from(entry, 0, protocol_end);
+            if (endpoint.protocol == keyword::PROTO_UNIX)
+            {
+                // The path of a unix domain socket may contain the split character
+                endpoint.address.substring_from(entry, protocol_end + 1, entry_length);
+                endpoint.port.clear();
+                valid_flag = endpoint.address.length() > 0;
+            }
+            else
+            if ((endpoint.protocol == keyword::PROTO_IPV4 || endpoint.protocol == keyword::PROTO_IPV6) &&
+                address_end > protocol_end)
+            {
+                size_t address_start = protocol_end + 1;
+                const size_t port_start = address_end + 1;
+                // Remove the brackets around an IPv6 address
+                if (address_end - address_start >= 2 && entry_data[address_start] == '[' &&
+                    entry_data[address_end - 1] == ']')
+                {
+                    ++address_start;
+                    --address_end;
+                }
+                endpoint.address.substring_from(entry, address_start, address_end);
+                endpoint.port.substring_from(entry, port_start, entry_length);
+                valid_flag = endpoint.address.length() > 0 && endpoint.port.length() > 0;
+            }
+        }
+    }
+    catch (RangeException&)
+    {
+        // No-op; handled the same way as a malformed entry
+    }
+
+    if (!valid_flag)
+    {
+        std::string error_msg("Invalid endpoint \"");
+        error_msg += entry_data;
+        error_msg += "\", endpoints must be specified as ";
+        error_msg += keyword::PROTO_IPV4;
+        error_msg += ":ADDRESS:PORT, ";
+        error_msg += keyword::PROTO_IPV6;
+        error_msg += ":[ADDRESS]:PORT or ";
+        error_msg += keyword::PROTO_UNIX;
+        error_msg += ":PATH";
+        throw Arguments::ArgumentsException(error_msg);
+    }
+}
+
+// @throws std::bad_alloc, ArgumentsException
+void ServerParameters::get_socket_tuning(socket_setup::Tuning& tuning)
+{
+    using Tuning = socket_setup::Tuning;
+    tuning.nodelay = get_count_value(KEY_TCP_NODELAY, 1, 0, 1) != 0;
+    tuning.quickack = get_count_value(KEY_TCP_QUICKACK, 0, 0, 1) != 0;
+    tuning.defer_accept = static_cast<uint32_t> (get_count_value(KEY_TCP_DEFER_ACCEPT, 0, 0, Tuning::MAX_DEFER_ACCEPT));
+    tuning.fastopen = static_cast<uint32_t> (get_count_value(KEY_TCP_FASTOPEN, 0, 0, Tuning::MAX_FASTOPEN_QUEUE));
+    tuning.recv_buffer_size = static_cast<uint32_t> (get_count_value(KEY_SO_RCVBUF, 0, 0, Tuning::MAX_BUFFER_SIZE));
+    tuning.send_buffer_size = static_cast<uint32_t> (get_count_value(KEY_SO_SNDBUF, 0, 0, Tuning::MAX_BUFFER_SIZE));
+    tuning.keepalive_idle = static_cast<uint32_t> (
+        get_count_value(KEY_TCP_KEEPIDLE, 0, 0, Tuning::MAX_KEEPALIVE_IDLE)
+    );
+    tuning.keepalive_interval = static_cast<uint32_t> (
+        get_count_value(KEY_TCP_KEEPINTVL, 0, 0, Tuning::MAX_KEEPALIVE_INTERVAL)
+    );
+    tuning.keepalive_count = static_cast<uint32_t> (
+        get_count_value(KEY_TCP_KEEPCNT, 0, 0, Tuning::MAX_KEEPALIVE_COUNT)
+    );
+    tuning.user_timeout = static_cast<uint32_t> (
+        get_count_value(KEY_TCP_USER_TIMEOUT, 0, 0, Tuning::MAX_USER_TIMEOUT)
+    );
+}
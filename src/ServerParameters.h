@@ -5,16 +5,67 @@
 #include <memory>
 #include <CharBuffer.h>
 #include "Arguments.h"
+#include "SelectorBackend.h"
+#include "Endpoint.h"
+#include "socket_setup.h"
+
+extern "C"
+{
+    #include <sys/types.h>
+}
 
 class ServerParameters : public Arguments
 {
   public:
     static const size_t MAX_PARAMETER_SIZE;
+    static const size_t MAX_SHARD_COUNT;
+    static const size_t DFLT_MAX_CONNECTIONS;
+    static const size_t MAX_MAX_CONNECTIONS;
+    static const size_t DFLT_CONNECTION_BACKLOG;
+    static const size_t MAX_CONNECTION_BACKLOG;
+    static const size_t DFLT_IDLE_TIMEOUT;
+    static const size_t MAX_IDLE_TIMEOUT;
+    static const size_t DFLT_RECV_TIMEOUT;
+    static const size_t DFLT_SEND_TIMEOUT;
+    static const size_t MAX_IO_TIMEOUT;
+    static const size_t MAX_MAX_WORKERS;
+    static const size_t DFLT_WORKER_IDLE_TIMEOUT;
+    static const size_t MAX_WORKER_IDLE_TIMEOUT;
+    static const size_t DFLT_FENCE_CACHE_TTL;
+    static const size_t MAX_FENCE_CACHE_TTL;
+    static const size_t MAX_PEER_UID;
+    static const size_t MAX_ENDPOINTS;
+    static const char ENDPOINT_SPLIT_CHAR;
+    static const char ENDPOINT_FIELD_SPLIT_CHAR;
 
     static const char* const KEY_PROTOCOL;
     static const char* const KEY_BIND_ADDRESS;
     static const char* const KEY_TCP_PORT;
     static const char* const KEY_FENCE_MODULE;
+    static const char* const KEY_SELECTOR;
+    static const char* const KEY_SHARDS;
+    static const char* const KEY_MAX_CONNECTIONS;
+    static const char* const KEY_BACKLOG;
+    static const char* const KEY_IDLE_TIMEOUT;
+    static const char* const KEY_RECV_TIMEOUT;
+    static const char* const KEY_SEND_TIMEOUT;
+    static const char* const KEY_MIN_WORKERS;
+    static const char* const KEY_MAX_WORKERS;
+    static const char* const KEY_WORKER_IDLE_TIMEOUT;
+    static const char* const KEY_FENCE_CACHE_TTL;
+    static const char* const KEY_LOCAL_SOCKET;
+    static const char* const KEY_PEER_UID;
+    static const char* const KEY_ENDPOINTS;
+    static const char* const KEY_TCP_NODELAY;
+    static const char* const KEY_TCP_QUICKACK;
+    static const char* const KEY_TCP_DEFER_ACCEPT;
+    static const char* const KEY_TCP_FASTOPEN;
+    static const char* const KEY_SO_RCVBUF;
+    static const char* const KEY_SO_SNDBUF;
+    static const char* const KEY_TCP_KEEPIDLE;
+    static const char* const KEY_TCP_KEEPINTVL;
+    static const char* const KEY_TCP_KEEPCNT;
+    static const char* const KEY_TCP_USER_TIMEOUT;
 
     static const CharBuffer OPT_PREFIX;
 
@@ -31,6 +82,103 @@ class ServerParameters : public Arguments
 
     // @throws std::bad_alloc, ArgumentsException
     virtual void read_parameters(int argc, const char* const argv[]);
+
+    // Returns the selector backend type selected by the optional selector parameter
+    // @throws std::bad_alloc, ArgumentsException
+    virtual SelectorBackend::Type get_selector_type();
+
+    // Returns the number of reactor shards selected by the optional shards parameter, or the number of
+    // CPUs available to the server if the parameter is not set, limited to MAX_SHARD_COUNT and to the
+    // maximum number of connections selected by the max_connections parameter
+    // @throws std::bad_alloc, ArgumentsException
+    virtual size_t get_shard_count();
+
+    // Returns the maximum number of connections per reactor shard: The maximum total number of connections
+    // selected by the optional max_connections parameter, divided across the reactor shards and rounded down
+    // @throws std::bad_alloc, ArgumentsException
+    virtual size_t get_max_connections(size_t shard_count);
+
+    // Returns the length of the server socket's queue of pending connections selected by the optional
+    // backlog parameter
+    // @throws std::bad_alloc, ArgumentsException
+    virtual size_t get_connection_backlog();
+
+    // Returns the time in seconds after which idle client connections are closed, selected by the
+    // optional idle_timeout parameter; 0 means that idle connections are never closed
+    // @throws std::bad_alloc, ArgumentsException
+    virtual size_t get_idle_timeout();
+
+    // Returns the time in seconds within which a client must complete sending a request once it
+    // has started sending the request, selected by the optional recv_timeout parameter;
+    // 0 means that there is no deadline
+    // @throws std::bad_alloc, ArgumentsException
+    virtual size_t get_recv_timeout();
+
+    // Returns the time in seconds after which a client connection is closed if the client does not
+    // accept any data of a pending reply, selected by the optional send_timeout parameter;
+    // 0 means that there is no deadline
+    // @throws std::bad_alloc, ArgumentsException
+    virtual size_t get_send_timeout();
+
+    // Returns the minimum number of worker threads per reactor shard: The minimum total number of worker
+    // threads selected by the optional min_workers parameter, or the number of CPUs available to the server
+    // if the parameter is not set, divided across the reactor shards and rounded down, but at least 1
+    // @throws std::bad_alloc, ArgumentsException
+    virtual size_t get_min_workers(size_t shard_count);
+
+    // Returns the maximum number of worker threads per reactor shard: The maximum total number of worker
+    // threads selected by the optional max_workers parameter, or the maximum total number of connections
+    // if the parameter is not set, divided across the reactor shards and rounded down, but at least 1
+    // @throws std::bad_alloc, ArgumentsException
+    virtual size_t get_max_workers(size_t shard_count);
+
+    // Returns the time in seconds after which worker threads in excess of the minimum number of worker
+    // threads terminate if they are idle, selected by the optional worker_idle_timeout parameter
+    // @throws std::bad_alloc, ArgumentsException
+    virtual size_t get_worker_idle_timeout();
+
+    // Returns the time in seconds for which the results of successful fencing actions are cached, selected
+    // by the optional fence_cache_ttl parameter, or 0 if the parameter is not set, which disables the cache
+    // @throws std::bad_alloc, ArgumentsException
+    virtual size_t get_fence_cache_ttl();
+
+    // Returns the user ID that is allowed to connect on unix domain sockets in addition to the superuser
+    // and the server's effective user, selected by the optional peer_uid parameter, or the server's
+    // effective user ID if the parameter is not set
+    // @throws std::bad_alloc, ArgumentsException
+    virtual uid_t get_peer_uid();
+
+    // Returns the list of endpoints that the server listens on
+    //
+    // The list contains the endpoint selected by the protocol, bind_address and tcp_port parameters,
+    // if the protocol parameter is set, the unix domain socket selected by the local_socket parameter,
+    // if it is set, and the endpoints of the endpoints parameter.
+    // The endpoints parameter is a comma-separated list of PROTOCOL:ADDRESS:PORT entries, e.g.
+    // IPV4:192.168.1.10:7000,IPV6:[fd00::10]:7000,UNIX:/run/ufh.sock
+    // @throws std::bad_alloc, ArgumentsException
+    virtual std::unique_ptr<Endpoint[]> get_endpoint_list(size_t& endpoint_count);
+
+    // Reads the socket options selected by the optional socket tuning parameters
+    // TCP_NODELAY is enabled by default, all other options are left at the system's defaults by default
+    // @throws std::bad_alloc, ArgumentsException
+    virtual void get_socket_tuning(socket_setup::Tuning& tuning);
+
+  private:
+    // Returns the number of CPUs that the server may run on, limited by the CPU quota of the server's
+    // cgroup, if there is one
+    size_t get_cpu_count() noexcept;
+
+    // Returns the maximum total number of connections of all reactor shards, selected by the optional
+    // max_connections parameter
+    // @throws std::bad_alloc, ArgumentsException
+    size_t get_total_connections();
+
+    // Divides a total across the reactor shards, rounding down, but returns at least 1
+    static size_t divide_across_shards(size_t total, size_t shard_count) noexcept;
+
+    // Parses a single entry of the endpoints parameter
+    // @throws std::bad_alloc, ArgumentsException
+    void parse_endpoint(const CharBuffer& entry, Endpoint& endpoint);
 };
 
 #endif /* SERVERPARAMETERS_H */
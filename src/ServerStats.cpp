@@ -0,0 +1,16 @@
+#include "ServerStats.h"
+
+ServerStats::ServerStats()
+{
+    idle_timeouts.store(0);
+    recv_timeouts.store(0);
+    send_timeouts.store(0);
+    fence_coalesced.store(0);
+    fence_serialized.store(0);
+    fence_cache_hits.store(0);
+    fence_cache_misses.store(0);
+}
+
+ServerStats::~ServerStats() noexcept
+{
+}
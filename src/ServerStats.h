@@ -0,0 +1,33 @@
+#ifndef SERVERSTATS_H
+#define SERVERSTATS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+
+// Server statistics for monitoring, shared by all reactor shards
+class ServerStats
+{
+  public:
+    // Number of connections closed due to an expired deadline
+    std::atomic<uint64_t>   idle_timeouts;
+    std::atomic<uint64_t>   recv_timeouts;
+    std::atomic<uint64_t>   send_timeouts;
+    // Number of fencing actions that received the result of an identical concurrent fencing action
+    std::atomic<uint64_t>   fence_coalesced;
+    // Number of fencing actions that waited for a conflicting fencing action affecting the same node
+    std::atomic<uint64_t>   fence_serialized;
+    // Number of fencing actions answered from the result cache, and number of fencing actions executed
+    // while the result cache is enabled
+    std::atomic<uint64_t>   fence_cache_hits;
+    std::atomic<uint64_t>   fence_cache_misses;
+
+    ServerStats();
+    virtual ~ServerStats() noexcept;
+    ServerStats(const ServerStats& other) = delete;
+    ServerStats(ServerStats&& orig) = delete;
+    virtual ServerStats& operator=(const ServerStats& other) = delete;
+    virtual ServerStats& operator=(ServerStats&& orig) = delete;
+};
+
+#endif /* SERVERSTATS_H */
@@ -28,7 +28,7 @@ namespace sys
 
 namespace ufh
 {
-    const char WAKEUP_TRIGGER_BYTE = static_cast<char> (0xFF);
+    const uint64_t WAKEUP_TRIGGER_VALUE = 1;
 
     const char* const LOGPFX_START      = "[ START ] ";
     const char* const LOGPFX_STOP       = "[ STOP  ] ";
@@ -49,15 +49,24 @@ namespace keyword
 {
     const char* const PROTO_IPV4 = "IPV4";
     const char* const PROTO_IPV6 = "IPV6";
+    const char* const PROTO_UNIX = "UNIX";
+
+    const char* const SELECTOR_SELECT   = "SELECT";
+    const char* const SELECTOR_EPOLL    = "EPOLL";
 }
 
 namespace constraints
 {
     const size_t PROTOCOL_PARAM_SIZE    = 10;
-    const size_t IP_ADDR_PARAM_SIZE     = 60;
+    // Also holds the path of a unix domain socket
+    const size_t IP_ADDR_PARAM_SIZE     = 108;
     const size_t PORT_PARAM_SIZE        = 6;
+    const size_t SELECTOR_PARAM_SIZE    = 10;
+    const size_t COUNT_PARAM_SIZE       = 10;
     const size_t SECRET_PARAM_SIZE      = 64;
     const size_t NODENAME_PARAM_SIZE    = 255;
+    const size_t NODELIST_PARAM_SIZE    = 500;
+    const size_t ENDPOINTS_PARAM_SIZE   = 1000;
     const size_t MODULE_PARAM_SIZE      = 1024;
     const size_t ACTION_PARAM_SIZE      = 24;
 }
@@ -68,8 +77,34 @@ namespace protocol
 
     const char* const NODENAME  = "NODENAME";
     const char* const SECRET    = "SECRET";
+    const char* const VERSION       = "VERSION";
+    const char* const VERSION_CODE  = "VERSION_CODE";
+    const char* const RESULTS       = "RESULTS";
+    const char* const IDLE_TIMEOUTS = "IDLE_TIMEOUTS";
+    const char* const RECV_TIMEOUTS = "RECV_TIMEOUTS";
+    const char* const SEND_TIMEOUTS = "SEND_TIMEOUTS";
+    const char* const FENCE_COALESCED   = "FENCE_COALESCED";
+    const char* const FENCE_SERIALIZED  = "FENCE_SERIALIZED";
+    const char* const FENCE_CACHE_HITS      = "FENCE_CACHE_HITS";
+    const char* const FENCE_CACHE_MISSES    = "FENCE_CACHE_MISSES";
+    const char* const WORKER_QUEUE_DEPTH    = "WORKER_QUEUE_DEPTH";
+    const char* const WORKER_QUEUE_DEPTH_HIGH   = "WORKER_QUEUE_DEPTH_HIGH";
+    const char* const WORKER_QUEUE_DEPTH_NORMAL = "WORKER_QUEUE_DEPTH_NORMAL";
+    const char* const WORKER_QUEUE_DEPTH_LOW    = "WORKER_QUEUE_DEPTH_LOW";
+    const char* const WORKER_AGED_TASKS     = "WORKER_AGED_TASKS";
+    const char* const WORKER_STEALS         = "WORKER_STEALS";
+    const char* const WORKER_PARK_TIME_MS   = "WORKER_PARK_TIME_MS";
+    const char* const WORKER_THREADS        = "WORKER_THREADS";
+    const char* const WORKER_SPAWNS         = "WORKER_SPAWNS";
+    const char* const WORKER_RETIREMENTS    = "WORKER_RETIREMENTS";
+    const char* const SOCKOPT_PREFIX    = "SOCKOPT_";
+    const char* const SOCKOPT_FAILURES  = "SOCKOPT_FAILURES";
+
+    const char RESULT_SUCCESS   = 'S';
+    const char RESULT_FAIL      = 'F';
 
-    const size_t MAX_SECRET_LENGTH = 64;
+    const size_t MAX_SECRET_LENGTH  = 64;
+    const size_t MAX_BATCH_NODES    = 64;
 
     // @throws ProtocolException
     static void write_field_impl(
@@ -154,6 +189,47 @@ namespace protocol
         return have_field;
     }
 
+    DecodeStatus decode_field(
+        const char* const   io_buffer,
+        const size_t        io_buffer_capacity,
+        size_t&             offset,
+        FieldView&          field
+    ) noexcept
+    {
+        DecodeStatus status = DecodeStatus::TRUNCATED_FIELD;
+        field.clear();
+        if (offset < io_buffer_capacity && io_buffer_capacity - offset >= 2)
+        {
+            uint16_t field_length = static_cast<unsigned char> (io_buffer[offset]) << 8;
+            field_length |= static_cast<unsigned char> (io_buffer[offset + 1]);
+
+            const size_t remain_length = io_buffer_capacity - offset - 2;
+            if (field_length <= remain_length)
+            {
+                field.data = &(io_buffer[offset + 2]);
+                field.length = field_length;
+                offset += field_length + 2;
+                status = DecodeStatus::OK;
+            }
+        }
+        return status;
+    }
+
+    // @throws ProtocolException
+    bool read_field(
+        const char* const   io_buffer,
+        const size_t        io_buffer_capacity,
+        size_t&             offset,
+        FieldView&          field
+    )
+    {
+        if (decode_field(io_buffer, io_buffer_capacity, offset, field) != DecodeStatus::OK)
+        {
+            throw ProtocolException();
+        }
+        return true;
+    }
+
     // @throws ProtocolException
     void write_field(
         char* const io_buffer,
@@ -258,4 +334,146 @@ namespace protocol
             throw ProtocolException();
         }
     }
+
+    DecodeStatus decode_key_value_pair(
+        const FieldView& field,
+        FieldView& key,
+        FieldView& value
+    ) noexcept
+    {
+        const char* const split_seq = KEY_VALUE_SPLIT_SEQ.c_str();
+        const size_t split_seq_length = KEY_VALUE_SPLIT_SEQ.length();
+
+        bool have_split_idx = false;
+        size_t split_idx = 0;
+        while (!have_split_idx && split_seq_length <= field.length && split_idx <= field.length - split_seq_length)
+        {
+            size_t seq_idx = 0;
+            while (seq_idx < split_seq_length && field.data[split_idx + seq_idx] == split_seq[seq_idx])
+            {
+                ++seq_idx;
+            }
+            if (seq_idx == split_seq_length)
+            {
+                have_split_idx = true;
+            }
+            else
+            {
+                ++split_idx;
+            }
+        }
+
+        DecodeStatus status = DecodeStatus::MISSING_SPLIT_SEQ;
+        if (have_split_idx)
+        {
+            key.data = field.data;
+            key.length = split_idx;
+            value.data = &(field.data[split_idx + split_seq_length]);
+            value.length = field.length - split_idx - split_seq_length;
+            status = DecodeStatus::OK;
+        }
+        return status;
+    }
+
+    // @throws ProtocolException
+    void split_key_value_pair(
+        const FieldView& field,
+        FieldView& key,
+        FieldView& value
+    )
+    {
+        if (decode_key_value_pair(field, key, value) != DecodeStatus::OK)
+        {
+            throw ProtocolException();
+        }
+    }
+
+    const char* get_decode_status_text(const DecodeStatus status) noexcept
+    {
+        const char* text = "Unknown error";
+        switch (status)
+        {
+            case DecodeStatus::OK:
+                text = "No error";
+                break;
+            case DecodeStatus::TRUNCATED_FIELD:
+                text = "Truncated field";
+                break;
+            case DecodeStatus::MISSING_SPLIT_SEQ:
+                text = "Field is not a key/value pair";
+                break;
+            case DecodeStatus::VALUE_TOO_LONG:
+                text = "Value too long";
+                break;
+            case DecodeStatus::INVALID_VALUE:
+                text = "Invalid value";
+                break;
+            default:
+                break;
+        }
+        return text;
+    }
+
+    FieldView::FieldView()
+    {
+    }
+
+    FieldView::~FieldView() noexcept
+    {
+    }
+
+    void FieldView::clear() noexcept
+    {
+        data = nullptr;
+        length = 0;
+    }
+
+    bool FieldView::equals(const char* const str) const noexcept
+    {
+        size_t idx = 0;
+        while (idx < length && str[idx] != '\0' && str[idx] == data[idx])
+        {
+            ++idx;
+        }
+        return idx == length && str[idx] == '\0';
+    }
+
+    // @throws ProtocolException
+    void FieldView::copy_to(CharBuffer& dst_buffer) const
+    {
+        try
+        {
+            dst_buffer.clear();
+            if (length > 0)
+            {
+                dst_buffer.substring_raw_from(data, 0, length);
+            }
+        }
+        catch (RangeException&)
+        {
+            throw ProtocolException();
+        }
+    }
+
+    DecodeStatus FieldView::decode_to(CharBuffer& dst_buffer, const size_t max_length) const noexcept
+    {
+        DecodeStatus status = DecodeStatus::VALUE_TOO_LONG;
+        dst_buffer.clear();
+        if (length <= max_length)
+        {
+            try
+            {
+                if (length > 0)
+                {
+                    dst_buffer.substring_raw_from(data, 0, length);
+                }
+                status = DecodeStatus::OK;
+            }
+            catch (RangeException&)
+            {
+                // Unreachable if max_length does not exceed the capacity of the buffer
+            }
+        }
+        return status;
+    }
 }
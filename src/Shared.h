@@ -2,6 +2,7 @@
 #define SHARED_H
 
 #include <CharBuffer.h>
+#include <cstdint>
 #include <string>
 
 extern "C"
@@ -21,7 +22,8 @@ namespace sys
 
 namespace ufh
 {
-    extern const char WAKEUP_TRIGGER_BYTE;
+    // Value written to a selector wakeup eventfd
+    extern const uint64_t WAKEUP_TRIGGER_VALUE;
 
     extern const char* const LOGPFX_START;
     extern const char* const LOGPFX_STOP;
@@ -42,6 +44,10 @@ namespace keyword
 {
     extern const char* const PROTO_IPV4;
     extern const char* const PROTO_IPV6;
+    extern const char* const PROTO_UNIX;
+
+    extern const char* const SELECTOR_SELECT;
+    extern const char* const SELECTOR_EPOLL;
 }
 
 namespace constraints
@@ -49,8 +55,12 @@ namespace constraints
     extern const size_t PROTOCOL_PARAM_SIZE;
     extern const size_t IP_ADDR_PARAM_SIZE;
     extern const size_t PORT_PARAM_SIZE;
+    extern const size_t SELECTOR_PARAM_SIZE;
+    extern const size_t COUNT_PARAM_SIZE;
     extern const size_t SECRET_PARAM_SIZE;
     extern const size_t NODENAME_PARAM_SIZE;
+    extern const size_t NODELIST_PARAM_SIZE;
+    extern const size_t ENDPOINTS_PARAM_SIZE;
     extern const size_t MODULE_PARAM_SIZE;
     extern const size_t ACTION_PARAM_SIZE;
 }
@@ -61,19 +71,104 @@ namespace protocol
 
     extern const char* const NODENAME;
     extern const char* const SECRET;
+    extern const char* const VERSION;
+    extern const char* const VERSION_CODE;
+    extern const char* const RESULTS;
+    extern const char* const IDLE_TIMEOUTS;
+    extern const char* const RECV_TIMEOUTS;
+    extern const char* const SEND_TIMEOUTS;
+    extern const char* const FENCE_COALESCED;
+    extern const char* const FENCE_SERIALIZED;
+    extern const char* const FENCE_CACHE_HITS;
+    extern const char* const FENCE_CACHE_MISSES;
+    extern const char* const WORKER_QUEUE_DEPTH;
+    extern const char* const WORKER_QUEUE_DEPTH_HIGH;
+    extern const char* const WORKER_QUEUE_DEPTH_NORMAL;
+    extern const char* const WORKER_QUEUE_DEPTH_LOW;
+    extern const char* const WORKER_AGED_TASKS;
+    extern const char* const WORKER_STEALS;
+    extern const char* const WORKER_PARK_TIME_MS;
+    extern const char* const WORKER_THREADS;
+    extern const char* const WORKER_SPAWNS;
+    extern const char* const WORKER_RETIREMENTS;
+    // Statistics fields with the number of sockets that a socket option was applied to are named
+    // SOCKOPT_PREFIX followed by the name of the socket option
+    extern const char* const SOCKOPT_PREFIX;
+    extern const char* const SOCKOPT_FAILURES;
+
+    // Per-node result values in the RESULTS field of a batch fence reply
+    extern const char RESULT_SUCCESS;
+    extern const char RESULT_FAIL;
 
     extern const size_t MAX_SECRET_LENGTH;
+    extern const size_t MAX_BATCH_NODES;
 
     enum class MsgType : uint16_t
     {
-        ECHO_REQUEST    = 0x0,
-        ECHO_REPLY      = 0x1,
-        VERSION_REQUEST = 0x2,
-        FENCE_OFF       = 0x81,
-        FENCE_ON        = 0x82,
-        FENCE_REBOOT    = 0x83,
-        FENCE_SUCCESS   = 0xA0,
-        FENCE_FAIL      = 0xA1
+        ECHO_REQUEST        = 0x0,
+        ECHO_REPLY          = 0x1,
+        VERSION_REQUEST     = 0x2,
+        VERSION_REPLY       = 0x3,
+        // The reply to a statistics request contains one NAME=VALUE field per counter
+        STATS_REQUEST       = 0x4,
+        STATS_REPLY         = 0x5,
+        FENCE_OFF           = 0x81,
+        FENCE_ON            = 0x82,
+        FENCE_REBOOT        = 0x83,
+        // Batch fence requests carry one NODENAME field per node
+        FENCE_OFF_BATCH     = 0x91,
+        FENCE_ON_BATCH      = 0x92,
+        FENCE_REBOOT_BATCH  = 0x93,
+        FENCE_SUCCESS       = 0xA0,
+        FENCE_FAIL          = 0xA1,
+        // Reply to a batch fence request, the RESULTS field contains one result value per node,
+        // in the order of the NODENAME fields of the request
+        FENCE_BATCH_RESULT  = 0xA2
+    };
+
+    // Result of the decode functions, which report malformed data without throwing exceptions, so that
+    // decoding garbage sent by a misbehaving peer remains cheap
+    enum class DecodeStatus : uint8_t
+    {
+        OK                  = 0,
+        // The field length exceeds the length of the remaining data
+        TRUNCATED_FIELD     = 1,
+        // The field does not contain the key/value split sequence
+        MISSING_SPLIT_SEQ   = 2,
+        // The value exceeds the maximum length of its destination
+        VALUE_TOO_LONG      = 3,
+        // The value is not acceptable, e.g. empty or exceeding a limit on the number of values
+        INVALID_VALUE       = 4
+    };
+
+    const char* get_decode_status_text(DecodeStatus status) noexcept;
+
+    // Non-owning reference to data in an I/O buffer, e.g. the contents of a field or its key or value
+    // The view is valid as long as the referenced data is not modified
+    class FieldView
+    {
+      public:
+        const char* data    = nullptr;
+        size_t      length  = 0;
+
+        FieldView();
+        virtual ~FieldView() noexcept;
+        FieldView(const FieldView& other) = default;
+        FieldView(FieldView&& orig) = default;
+        virtual FieldView& operator=(const FieldView& other) = default;
+        virtual FieldView& operator=(FieldView&& orig) = default;
+
+        virtual void clear() noexcept;
+
+        virtual bool equals(const char* str) const noexcept;
+
+        // Copies the referenced data into the buffer, for data that must outlive the I/O buffer
+        // @throws ProtocolException if the data exceeds the capacity of the buffer
+        virtual void copy_to(CharBuffer& dst_buffer) const;
+
+        // Copies the referenced data into the buffer if its length does not exceed max_length,
+        // which must not exceed the capacity of the buffer
+        virtual DecodeStatus decode_to(CharBuffer& dst_buffer, size_t max_length) const noexcept;
     };
 
     // @throws ProtocolException
@@ -92,6 +187,31 @@ namespace protocol
         std::string& field_contents
     );
 
+    // Sets the field view to the contents of the field, without copying the contents,
+    // and advances the offset to the next field
+    DecodeStatus decode_field(
+        const char* io_buffer,
+        size_t io_buffer_capacity,
+        size_t& offset,
+        FieldView& field
+    ) noexcept;
+
+    // Sets the key and value views to the parts of the field, which remains unmodified
+    DecodeStatus decode_key_value_pair(
+        const FieldView& field,
+        FieldView& key,
+        FieldView& value
+    ) noexcept;
+
+    // Throwing variant of decode_field()
+    // @throws ProtocolException
+    bool read_field(
+        const char* io_buffer,
+        size_t io_buffer_capacity,
+        size_t& offset,
+        FieldView& field
+    );
+
     // @throws ProtocolException
     void write_field(
         char* io_buffer,
@@ -119,6 +239,14 @@ namespace protocol
         std::string& src_data,
         std::string& value
     );
+
+    // Throwing variant of decode_key_value_pair()
+    // @throws ProtocolException
+    void split_key_value_pair(
+        const FieldView& field,
+        FieldView& key,
+        FieldView& value
+    );
 }
 
 #endif /* SHARED_H */
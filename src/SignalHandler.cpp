@@ -2,11 +2,14 @@
 #include "exceptions.h"
 #include "Shared.h"
 
+const size_t        SignalHandler::MAX_WAKEUP_FDS   = 64;
+
 bool                SignalHandler::signal_flag      = false;
 std::mutex          SignalHandler::signal_lock;
 struct sigaction    SignalHandler::signal_action;
-// Wakeup pipe (write side file descriptor)
-int                 SignalHandler::wakeup_fd        = sys::FD_NONE;
+// Wakeup eventfds, one for each selector
+int                 SignalHandler::wakeup_fd_list[MAX_WAKEUP_FDS];
+size_t              SignalHandler::wakeup_fd_count  = 0;
 
 SignalHandler*      SignalHandler::instance         = nullptr;
 std::mutex          SignalHandler::class_lock;
@@ -65,6 +68,8 @@ void SignalHandler::signal() noexcept
     sigprocmask(SIG_BLOCK, &SignalHandler::signal_action.sa_mask, nullptr);
     SignalHandler::signal_lock.lock();
     SignalHandler::signal_flag = true;
+    // Wake up all selectors, so that every selector can observe the signal flag
+    trigger_wakeup_fds();
     SignalHandler::signal_lock.unlock();
     sigprocmask(SIG_UNBLOCK, &SignalHandler::signal_action.sa_mask, nullptr);
 }
@@ -79,43 +84,67 @@ bool SignalHandler::is_signaled() noexcept
     return local_flag;
 }
 
-void SignalHandler::enable_wakeup_fd(const int fd) noexcept
+bool SignalHandler::enable_wakeup_fd(const int fd) noexcept
 {
+    bool enabled = false;
     sigprocmask(SIG_BLOCK, &SignalHandler::signal_action.sa_mask, nullptr);
     SignalHandler::signal_lock.lock();
-    SignalHandler::wakeup_fd = fd;
+    if (SignalHandler::wakeup_fd_count < MAX_WAKEUP_FDS)
+    {
+        SignalHandler::wakeup_fd_list[SignalHandler::wakeup_fd_count] = fd;
+        ++SignalHandler::wakeup_fd_count;
+        enabled = true;
+    }
     SignalHandler::signal_lock.unlock();
     sigprocmask(SIG_UNBLOCK, &SignalHandler::signal_action.sa_mask, nullptr);
+    return enabled;
 }
 
-void SignalHandler::disable_wakeup_fd() noexcept
+void SignalHandler::disable_wakeup_fd(const int fd) noexcept
 {
     sigprocmask(SIG_BLOCK, &SignalHandler::signal_action.sa_mask, nullptr);
     SignalHandler::signal_lock.lock();
-    SignalHandler::wakeup_fd = sys::FD_NONE;
+    for (size_t idx = 0; idx < SignalHandler::wakeup_fd_count; ++idx)
+    {
+        if (SignalHandler::wakeup_fd_list[idx] == fd)
+        {
+            // Move the last entry into the free slot
+            --SignalHandler::wakeup_fd_count;
+            SignalHandler::wakeup_fd_list[idx] = SignalHandler::wakeup_fd_list[SignalHandler::wakeup_fd_count];
+            SignalHandler::wakeup_fd_list[SignalHandler::wakeup_fd_count] = sys::FD_NONE;
+            break;
+        }
+    }
     SignalHandler::signal_lock.unlock();
     sigprocmask(SIG_UNBLOCK, &SignalHandler::signal_action.sa_mask, nullptr);
 }
 
-extern "C"
-void ufh_signal_handler(const int signal_nr) noexcept
+// Caller must hold the signal_lock
+void SignalHandler::trigger_wakeup_fds() noexcept
 {
-    SignalHandler::signal_lock.lock();
-    SignalHandler::signal_flag = true;
-    if (SignalHandler::wakeup_fd != sys::FD_NONE)
+    for (size_t idx = 0; idx < SignalHandler::wakeup_fd_count; ++idx)
     {
-        // Write a trigger byte to the wakeup pipe
-        // Failure to write due to insufficient pipe capacity is ignored, to avoid becoming deadlocked
+        // Add the trigger value to the wakeup eventfd's counter
+        // Failure to write due to an overflow of the counter is ignored, to avoid becoming deadlocked
         // in the signal handler (since the thread that executes the signal handler may be the same thread
-        // that is supposed to read the wakeup pipe).
-        // Insufficient capacity in the wakeup pipe means that the wakeup pipe has already been
-        // triggered anyway.
+        // that is supposed to read the wakeup eventfd).
+        // An overflow of the counter means that the wakeup eventfd has already been triggered anyway.
         ssize_t write_length = 0;
         do
         {
-            write_length = write(SignalHandler::wakeup_fd, &ufh::WAKEUP_TRIGGER_BYTE, 1);
+            write_length = write(
+                SignalHandler::wakeup_fd_list[idx], &ufh::WAKEUP_TRIGGER_VALUE, sizeof (ufh::WAKEUP_TRIGGER_VALUE)
+            );
         }
         while (write_length == -1 && errno == EINTR);
     }
+}
+
+extern "C"
+void ufh_signal_handler(const int signal_nr) noexcept
+{
+    SignalHandler::signal_lock.lock();
+    SignalHandler::signal_flag = true;
+    SignalHandler::trigger_wakeup_fds();
     SignalHandler::signal_lock.unlock();
 }
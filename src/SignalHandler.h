@@ -1,6 +1,7 @@
 #ifndef SIGNALHANDLER_H
 #define SIGNALHANDLER_H
 
+#include <cstddef>
 #include <mutex>
 
 extern "C"
@@ -24,21 +25,29 @@ class SignalHandler
     virtual SignalHandler& operator=(const SignalHandler& other) = delete;
     virtual SignalHandler& operator=(SignalHandler&& orig) = delete;
 
+    static const size_t MAX_WAKEUP_FDS;
+
+    // Sets the signal flag and triggers all enabled wakeup eventfds
     virtual void signal() noexcept;
     virtual bool is_signaled() noexcept;
 
-    // Enable writing to a wakeup pipe
-    // The pipe must be in non-blocking mode to avoid becoming stuck in the signal handler
-    virtual void enable_wakeup_fd(int fd) noexcept;
+    // Enable writing to a wakeup eventfd
+    // The eventfd must be in non-blocking mode to avoid becoming stuck in the signal handler
+    // Returns false if the maximum number of wakeup eventfds is already enabled
+    virtual bool enable_wakeup_fd(int fd) noexcept;
+
+    // Disable writing to a wakeup eventfd
+    virtual void disable_wakeup_fd(int fd) noexcept;
 
-    // Disable writing to a wakeup pipe
-    virtual void disable_wakeup_fd() noexcept;
+    // Caller must hold the signal_lock
+    static void trigger_wakeup_fds() noexcept;
 
     static bool signal_flag;
     static std::mutex signal_lock;
     static struct sigaction signal_action;
-    // Wakeup pipe (write side file descriptor)
-    static int wakeup_fd;
+    // Wakeup eventfds, one for each selector
+    static int wakeup_fd_list[];
+    static size_t wakeup_fd_count;
 
   private:
     static SignalHandler* instance;
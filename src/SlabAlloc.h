@@ -0,0 +1,184 @@
+#ifndef SLABALLOC_H
+#define SLABALLOC_H
+
+#include <cstddef>
+#include <new>
+#include <memory>
+#include <mutex>
+
+// Allocator for a pool of objects that grows in slabs of a fixed number of objects,
+// up to a maximum number of objects
+//
+// Objects are constructed when the slab that contains them is added to the pool and are not
+// destroyed before the allocator is destroyed. Slabs are added on demand, when an allocation
+// is requested while there are no free objects left in the existing slabs.
+template<typename T>
+class SlabAlloc
+{
+  public:
+    class Dealloc
+    {
+      private:
+        SlabAlloc* allocator;
+
+      public:
+        Dealloc(SlabAlloc* const allocator_ref)
+        {
+            allocator = allocator_ref;
+        }
+        virtual ~Dealloc() noexcept
+        {
+        }
+        Dealloc(const Dealloc& other) = default;
+        Dealloc(Dealloc&& orig) = default;
+        virtual Dealloc& operator=(const Dealloc& other) = default;
+        virtual Dealloc& operator=(Dealloc&& orig) = default;
+        virtual void operator()(T* obj) const
+        {
+            allocator->deallocate(obj);
+        }
+    };
+
+  private:
+    mutable std::mutex                      lock;
+    Dealloc                                 deallocator = Dealloc(this);
+
+    size_t                                  slab_size;
+    size_t                                  max_size;
+    // Number of objects in all slabs
+    size_t                                  pool_size;
+
+    std::unique_ptr<std::unique_ptr<T[]>[]> slab_list_mgr;
+    std::unique_ptr<T[]>*                   slab_list;
+    size_t                                  slab_count;
+
+    std::unique_ptr<T*[]>                   free_list_mgr;
+    T**                                     free_list;
+    size_t                                  alloc_index;
+
+  public:
+    using scope_ptr = std::unique_ptr<T, SlabAlloc<T>::Dealloc&>;
+
+    // Initializes the pool with a single slab
+    // @throws std::bad_alloc
+    SlabAlloc(const size_t objects_per_slab, const size_t max_objects)
+    {
+        slab_size   = objects_per_slab >= 1 ? objects_per_slab : 1;
+        max_size    = max_objects;
+        pool_size   = 0;
+
+        const size_t max_slab_count = (max_size + slab_size - 1) / slab_size;
+        slab_list_mgr   = std::unique_ptr<std::unique_ptr<T[]>[]>(new std::unique_ptr<T[]>[max_slab_count]);
+        slab_list       = slab_list_mgr.get();
+        slab_count      = 0;
+
+        free_list_mgr   = std::unique_ptr<T*[]>(new T*[max_size]);
+        free_list       = free_list_mgr.get();
+        alloc_index     = 0;
+
+        add_slab();
+    }
+
+    virtual ~SlabAlloc() noexcept
+    {
+    }
+
+    SlabAlloc(const SlabAlloc& other) = delete;
+    SlabAlloc(SlabAlloc&& orig) = delete;
+    virtual SlabAlloc& operator=(const SlabAlloc& other) = delete;
+    virtual SlabAlloc& operator=(SlabAlloc&& orig) = delete;
+
+    // Returns the number of objects in all slabs that are currently part of the pool
+    virtual size_t get_pool_size() const
+    {
+        std::unique_lock<std::mutex> instance_lock(lock);
+        return pool_size;
+    }
+
+    // Returns the maximum number of objects that the pool can grow to
+    virtual size_t get_max_size() const
+    {
+        std::unique_lock<std::mutex> instance_lock(lock);
+        return max_size;
+    }
+
+    // Returns the number of objects that can be allocated, including objects in slabs that have
+    // not been added to the pool yet
+    virtual size_t get_free_count() const
+    {
+        std::unique_lock<std::mutex> instance_lock(lock);
+        return alloc_index + (max_size - pool_size);
+    }
+
+    virtual size_t get_allocated_count() const
+    {
+        std::unique_lock<std::mutex> instance_lock(lock);
+        return pool_size - alloc_index;
+    }
+
+    // @throws std::bad_alloc
+    virtual T* allocate()
+    {
+        std::unique_lock<std::mutex> instance_lock(lock);
+        if (alloc_index == 0 && pool_size < max_size)
+        {
+            add_slab();
+        }
+
+        T* obj {nullptr};
+        if (alloc_index > 0)
+        {
+            --alloc_index;
+            obj = free_list[alloc_index];
+        }
+        else
+        {
+            throw std::bad_alloc();
+        }
+        return obj;
+    }
+
+    virtual void deallocate(T* obj)
+    {
+        std::unique_lock<std::mutex> instance_lock(lock);
+        if (alloc_index < pool_size)
+        {
+            free_list[alloc_index] = obj;
+            ++alloc_index;
+        }
+    }
+
+    virtual scope_ptr allocate_scope()
+    {
+        return scope_ptr(allocate(), this->deallocator);
+    }
+
+    virtual scope_ptr make_scope_ptr(T* obj)
+    {
+        return scope_ptr(obj, this->deallocator);
+    }
+
+  private:
+    // Caller must hold the lock
+    // @throws std::bad_alloc
+    void add_slab()
+    {
+        const size_t remaining_size = max_size - pool_size;
+        const size_t crt_slab_size = remaining_size < slab_size ? remaining_size : slab_size;
+        if (crt_slab_size > 0)
+        {
+            slab_list[slab_count] = std::unique_ptr<T[]>(new T[crt_slab_size]);
+            T* const slab = slab_list[slab_count].get();
+            ++slab_count;
+
+            for (size_t idx = 0; idx < crt_slab_size; ++idx)
+            {
+                free_list[alloc_index] = &slab[idx];
+                ++alloc_index;
+            }
+            pool_size += crt_slab_size;
+        }
+    }
+};
+
+#endif /* SLABALLOC_H */
@@ -0,0 +1,198 @@
+#include "TimerWheel.h"
+
+const size_t TimerWheel::LEVEL_COUNT    = 4;
+const size_t TimerWheel::SLOT_BITS      = 6;
+const size_t TimerWheel::SLOT_COUNT     = 1 << SLOT_BITS;
+const uint64_t TimerWheel::SLOT_MASK    = SLOT_COUNT - 1;
+const uint64_t TimerWheel::MAX_DELAY    = (static_cast<uint64_t> (1) << (SLOT_BITS * LEVEL_COUNT)) - 1;
+const uint64_t TimerWheel::NO_EVENT     = ~static_cast<uint64_t> (0);
+
+// @throws std::bad_alloc
+TimerWheel::TimerWheel(const uint64_t start_tick)
+{
+    const size_t slot_list_size = LEVEL_COUNT * SLOT_COUNT;
+    slot_list_mgr = std::unique_ptr<Timer*[]>(new Timer*[slot_list_size]);
+    slot_list = slot_list_mgr.get();
+    for (size_t idx = 0; idx < slot_list_size; ++idx)
+    {
+        slot_list[idx] = nullptr;
+    }
+    current_tick = start_tick;
+}
+
+TimerWheel::~TimerWheel() noexcept
+{
+}
+
+void TimerWheel::arm(Timer* const timer, const uint64_t expiry_tick) noexcept
+{
+    if (timer->armed)
+    {
+        remove(timer);
+    }
+    else
+    {
+        timer->armed = true;
+        ++timer_count;
+    }
+    timer->expiry_tick = expiry_tick;
+    insert(timer);
+}
+
+void TimerWheel::cancel(Timer* const timer) noexcept
+{
+    if (timer->armed)
+    {
+        remove(timer);
+        timer->armed = false;
+        --timer_count;
+    }
+}
+
+TimerWheel::Timer* TimerWheel::advance(const uint64_t now_tick) noexcept
+{
+    Timer* expired_list = nullptr;
+    if (timer_count == 0 && now_tick >= current_tick)
+    {
+        // Nothing to cascade or expire, skip the ticks
+        current_tick = now_tick + 1;
+    }
+
+    while (current_tick <= now_tick)
+    {
+        const size_t index = static_cast<size_t> (current_tick & SLOT_MASK);
+        if (index == 0)
+        {
+            // Level 0 wrapped around, cascade the timers of the next slot of level 1 down to level 0,
+            // and likewise for each higher level that wrapped around
+            for (size_t level = 1; level < LEVEL_COUNT; ++level)
+            {
+                cascade(level, current_tick);
+                if (((current_tick >> (SLOT_BITS * level)) & SLOT_MASK) != 0)
+                {
+                    break;
+                }
+            }
+        }
+
+        Timer* timer = slot_list[index];
+        slot_list[index] = nullptr;
+        while (timer != nullptr)
+        {
+            Timer* const next_timer = timer->next_timer;
+            timer->armed = false;
+            timer->prev_timer = nullptr;
+            timer->next_timer = expired_list;
+            expired_list = timer;
+            --timer_count;
+            timer = next_timer;
+        }
+        ++current_tick;
+    }
+    return expired_list;
+}
+
+uint64_t TimerWheel::get_ticks_to_next_event(const uint64_t now_tick) const noexcept
+{
+    uint64_t ticks = NO_EVENT;
+    if (timer_count > 0)
+    {
+        // Either a timer on level 0 expires or timers are cascaded from the higher levels
+        // within a single rotation of level 0
+        for (uint64_t offset = 0; offset < SLOT_COUNT; ++offset)
+        {
+            const uint64_t tick = current_tick + offset;
+            if ((tick & SLOT_MASK) == 0 || slot_list[tick & SLOT_MASK] != nullptr)
+            {
+                ticks = tick > now_tick ? tick - now_tick : 0;
+                break;
+            }
+        }
+    }
+    return ticks;
+}
+
+size_t TimerWheel::get_timer_count() const noexcept
+{
+    return timer_count;
+}
+
+void TimerWheel::insert(Timer* const timer) noexcept
+{
+    if (timer->expiry_tick < current_tick)
+    {
+        timer->expiry_tick = current_tick;
+    }
+    uint64_t delay = timer->expiry_tick - current_tick;
+    if (delay > MAX_DELAY)
+    {
+        delay = MAX_DELAY;
+        timer->expiry_tick = current_tick + delay;
+    }
+
+    size_t level = 0;
+    while (level + 1 < LEVEL_COUNT && delay >= (static_cast<uint64_t> (1) << (SLOT_BITS * (level + 1))))
+    {
+        ++level;
+    }
+    timer->slot_index = level * SLOT_COUNT +
+        static_cast<size_t> ((timer->expiry_tick >> (SLOT_BITS * level)) & SLOT_MASK);
+
+    Timer* const head_timer = slot_list[timer->slot_index];
+    if (head_timer != nullptr)
+    {
+        head_timer->prev_timer = timer;
+    }
+    timer->next_timer = head_timer;
+    timer->prev_timer = nullptr;
+    slot_list[timer->slot_index] = timer;
+}
+
+void TimerWheel::remove(Timer* const timer) noexcept
+{
+    if (timer->prev_timer == nullptr)
+    {
+        slot_list[timer->slot_index] = timer->next_timer;
+    }
+    else
+    {
+        timer->prev_timer->next_timer = timer->next_timer;
+    }
+    if (timer->next_timer != nullptr)
+    {
+        timer->next_timer->prev_timer = timer->prev_timer;
+    }
+    timer->next_timer = nullptr;
+    timer->prev_timer = nullptr;
+}
+
+void TimerWheel::cascade(const size_t level, const uint64_t tick) noexcept
+{
+    const size_t slot_index = level * SLOT_COUNT + static_cast<size_t> ((tick >> (SLOT_BITS * level)) & SLOT_MASK);
+    Timer* timer = slot_list[slot_index];
+    slot_list[slot_index] = nullptr;
+    while (timer != nullptr)
+    {
+        Timer* const next_timer = timer->next_timer;
+        insert(timer);
+        timer = next_timer;
+    }
+}
+
+TimerWheel::Timer::Timer()
+{
+}
+
+TimerWheel::Timer::~Timer() noexcept
+{
+}
+
+bool TimerWheel::Timer::is_armed() const noexcept
+{
+    return armed;
+}
+
+TimerWheel::Timer* TimerWheel::Timer::get_next_expired() const noexcept
+{
+    return next_timer;
+}
@@ -0,0 +1,94 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Hierarchical timer wheel
+//
+// Time is measured in ticks. Each slot of level 0 covers a single tick, each slot of a higher level
+// covers all slots of the next lower level. Timers that expire beyond the range of level 0 are placed
+// on a higher level and are cascaded down to the lower levels as time advances, so that arming,
+// canceling and expiring a timer take constant time, regardless of the number of timers.
+//
+// Timers are intrusive, objects that can be scheduled must derive from TimerWheel::Timer.
+class TimerWheel
+{
+  public:
+    static const size_t     LEVEL_COUNT;
+    static const size_t     SLOT_BITS;
+    static const size_t     SLOT_COUNT;
+    static const uint64_t   SLOT_MASK;
+    // Maximum number of ticks between the current tick and the expiry tick of a timer,
+    // timers that are armed to expire later are clamped to the maximum
+    static const uint64_t   MAX_DELAY;
+    // Returned by get_ticks_to_next_event() if no timers are armed
+    static const uint64_t   NO_EVENT;
+
+    class Timer
+    {
+        friend class TimerWheel;
+
+      private:
+        Timer*      next_timer  = nullptr;
+        Timer*      prev_timer  = nullptr;
+        size_t      slot_index  = 0;
+        uint64_t    expiry_tick = 0;
+        bool        armed       = false;
+
+      public:
+        Timer();
+        virtual ~Timer() noexcept;
+        Timer(const Timer& other) = default;
+        Timer(Timer&& orig) = default;
+        virtual Timer& operator=(const Timer& other) = default;
+        virtual Timer& operator=(Timer&& orig) = default;
+
+        virtual bool is_armed() const noexcept;
+
+        // Returns the next timer on the list of expired timers returned by TimerWheel::advance()
+        virtual Timer* get_next_expired() const noexcept;
+    };
+
+    // @throws std::bad_alloc
+    TimerWheel(uint64_t start_tick);
+    virtual ~TimerWheel() noexcept;
+    TimerWheel(const TimerWheel& other) = delete;
+    TimerWheel(TimerWheel&& orig) = delete;
+    virtual TimerWheel& operator=(const TimerWheel& other) = delete;
+    virtual TimerWheel& operator=(TimerWheel&& orig) = delete;
+
+    // Arms the timer to expire at the specified tick, an armed timer is rearmed
+    // A timer that is armed to expire at a tick that has already been processed expires with the next tick
+    virtual void arm(Timer* timer, uint64_t expiry_tick) noexcept;
+
+    virtual void cancel(Timer* timer) noexcept;
+
+    // Processes all ticks up to and including now_tick
+    // Returns the list of expired timers, which are no longer armed, or nullptr if no timers expired
+    // The list is linked by Timer::get_next_expired() and is valid until the next timer operation
+    virtual Timer* advance(uint64_t now_tick) noexcept;
+
+    // Returns the number of ticks from now_tick until advance() must be called again for the next
+    // timer to expire or for the next cascade of timers from the higher levels, or NO_EVENT if
+    // no timers are armed
+    virtual uint64_t get_ticks_to_next_event(uint64_t now_tick) const noexcept;
+
+    virtual size_t get_timer_count() const noexcept;
+
+  private:
+    std::unique_ptr<Timer*[]>   slot_list_mgr;
+    Timer**                     slot_list       = nullptr;
+    // Next tick to process
+    uint64_t                    current_tick    = 0;
+    size_t                      timer_count     = 0;
+
+    void insert(Timer* timer) noexcept;
+    void remove(Timer* timer) noexcept;
+
+    // Reinserts all timers of a slot of a higher level, which places them on lower levels
+    void cascade(size_t level, uint64_t tick) noexcept;
+};
+
+#endif /* TIMERWHEEL_H */
@@ -1,16 +1,56 @@
 #include "WorkerPool.h"
 
 #include <iostream>
+#include <chrono>
+#include <algorithm>
 #include "Shared.h"
 
-WorkerPool::WorkerPool(std::mutex* const lock, const size_t worker_count, WorkerPoolExecutor* const executor)
+const size_t WorkerPool::LOCAL_QUEUE_SIZE   = 64;
+const uint64_t WorkerPool::AGING_LIMIT      = 16;
+
+thread_local WorkerPool::Worker* WorkerPool::current_worker = nullptr;
+
+// @throws std::bad_alloc
+WorkerPool::WorkerPool(
+    const size_t min_worker_count,
+    const size_t max_worker_count,
+    const std::chrono::milliseconds worker_idle_timeout,
+    const size_t max_task_count,
+    WorkerPoolExecutor* const executor
+):
+    idle_timeout(worker_idle_timeout)
 {
     std::cout << ufh::LOGPFX_START << "Initializing thread pool" << std::endl;
-    pool_lock = lock;
-    pool_size = worker_count;
-    pool_threads_mgr = std::unique_ptr<std::thread[]>(new std::thread[pool_size]);
-    pool_threads = pool_threads_mgr.get();
+    // Tasks that do not fit into the shared queue of their own priority level are queued on the shared
+    // queues of other priority levels, therefore the shared queues only need to add up to max_task_count
+    const size_t level_task_count = (max_task_count + PRIORITY_COUNT - 1) / PRIORITY_COUNT;
+    for (size_t level = 0; level < PRIORITY_COUNT; ++level)
+    {
+        shared_queue_list[level] = std::unique_ptr<MpmcQueue<Task>>(new MpmcQueue<Task>(level_task_count));
+        level_queued_count[level].store(0);
+        bypass_count[level].store(0);
+    }
+    pool_size = max_worker_count >= 1 ? max_worker_count : 1;
+    min_workers = min_worker_count >= 1 ? std::min(min_worker_count, pool_size) : 1;
+    worker_list_mgr = std::unique_ptr<Worker[]>(new Worker[pool_size]);
+    worker_list = worker_list_mgr.get();
+    for (size_t idx = 0; idx < pool_size; ++idx)
+    {
+        worker_list[idx].pool = this;
+        worker_list[idx].index = idx;
+    }
     pool_executor = executor;
+
+    stop_workers.store(false);
+    live_count.store(0);
+    idle_count.store(0);
+    next_worker.store(0);
+    queued_count.store(0);
+    steal_count.store(0);
+    aged_count.store(0);
+    park_time.store(0);
+    spawn_count.store(0);
+    retire_count.store(0);
 }
 
 WorkerPool::~WorkerPool() noexcept
@@ -19,43 +59,53 @@ WorkerPool::~WorkerPool() noexcept
     std::cout << ufh::LOGPFX_STOP << "Uninitializing worker pool" << std::endl;
 }
 
-WorkerPool::WorkerPool(WorkerPool&& orig)
+WorkerPool::Task::Task()
 {
-    std::unique_lock<std::mutex> lock(*(orig.pool_lock));
+}
 
-    pool_lock = orig.pool_lock;
-    pool_threads_mgr = std::move(orig.pool_threads_mgr);
-    pool_threads = orig.pool_threads;
-    pool_size = orig.pool_size;
-    pool_executor = orig.pool_executor;
-    orig.pool_lock = nullptr;
-    orig.pool_threads = nullptr;
-    orig.pool_executor = nullptr;
+WorkerPool::Task::~Task() noexcept
+{
 }
 
 WorkerPool::WorkerPoolExecutor::~WorkerPoolExecutor() noexcept
 {
 }
 
+// @throws std::bad_alloc
+WorkerPool::Worker::Worker()
+{
+    // Tasks that do not fit into a local queue are queued on the shared queues
+    const size_t level_task_count = (LOCAL_QUEUE_SIZE + PRIORITY_COUNT - 1) / PRIORITY_COUNT;
+    for (size_t level = 0; level < PRIORITY_COUNT; ++level)
+    {
+        local_queue_list[level] = std::unique_ptr<MpmcQueue<Task>>(new MpmcQueue<Task>(level_task_count));
+    }
+    parked.store(false);
+    live.store(false);
+}
+
+WorkerPool::Worker::~Worker() noexcept
+{
+}
+
 // @throws std::system_error
 void WorkerPool::start()
 {
     std::cout << ufh::LOGPFX_START << "Starting worker threads" << std::endl;
-    std::unique_lock<std::mutex> lock(*pool_lock);
+    std::cout << ufh::LOGPFX_CONT << "Minimum worker threads = " << min_workers <<
+        ", maximum worker threads = " << pool_size << ", idle timeout = " << idle_timeout.count() <<
+        " ms" << std::endl;
     try
     {
-        for (size_t idx = 0; idx < pool_size; ++idx)
+        std::unique_lock<std::mutex> lock(spawn_lock);
+        for (size_t idx = 0; idx < min_workers; ++idx)
         {
-            pool_threads[idx] = std::thread(&WorkerPool::worker_loop, this);
+            start_worker();
         }
     }
     catch (std::system_error&)
     {
-        stop_workers = true;
-        pool_condition.notify_all();
-        lock.unlock();
-
-        await_threads_termination();
+        stop_threads();
         throw;
     }
 }
@@ -65,35 +115,386 @@ void WorkerPool::stop() noexcept
     stop_threads();
 }
 
-void WorkerPool::notify() noexcept
+bool WorkerPool::submit(Task* const task, const Priority priority) noexcept
+{
+    const size_t level = static_cast<size_t> (priority);
+
+    // The queued_count must be incremented before the task becomes visible to worker threads,
+    // see park()
+    queued_count.fetch_add(1);
+
+    bool queued = false;
+    Worker* const worker = current_worker;
+    if (worker != nullptr && worker->pool == this)
+    {
+        // Tasks submitted by a worker thread are queued on its own queue, other worker threads steal
+        // those tasks if the submitting worker thread is busy
+        queued = enqueue_task(*(worker->local_queue_list[level]), level, task);
+    }
+    // Tasks submitted by other threads are queued on the shared queue, so that they are taken in the order
+    // of submission by whichever worker thread becomes available first
+    // If the shared queue of the task's priority level is full, the shared queues of the lower priority
+    // levels are tried next, and then the shared queues of the higher priority levels, starting with the
+    // nearest priority level
+    for (size_t offset = 0; !queued && offset < PRIORITY_COUNT; ++offset)
+    {
+        const size_t queue_level = level + offset < PRIORITY_COUNT ? level + offset : PRIORITY_COUNT - 1 - offset;
+        queued = enqueue_task(*(shared_queue_list[queue_level]), queue_level, task);
+    }
+
+    if (queued)
+    {
+        // If no worker thread is parked, all worker threads are busy
+        if (!unpark_worker())
+        {
+            add_worker();
+        }
+    }
+    else
+    {
+        queued_count.fetch_sub(1);
+    }
+    return queued;
+}
+
+bool WorkerPool::enqueue_task(MpmcQueue<Task>& queue, const size_t level, Task* const task) noexcept
+{
+    // The level_queued_count must be incremented before the task becomes visible to worker threads,
+    // since worker threads skip priority levels without queued tasks, see find_task()
+    level_queued_count[level].fetch_add(1);
+    const bool queued = queue.enqueue(task);
+    if (!queued)
+    {
+        level_queued_count[level].fetch_sub(1);
+    }
+    return queued;
+}
+
+WorkerPool::Task* WorkerPool::take() noexcept
+{
+    Task* task = nullptr;
+    for (size_t level = 0; task == nullptr && level < PRIORITY_COUNT; ++level)
+    {
+        task = shared_queue_list[level]->dequeue();
+        for (size_t idx = 0; task == nullptr && idx < pool_size; ++idx)
+        {
+            task = worker_list[idx].local_queue_list[level]->dequeue();
+        }
+        if (task != nullptr)
+        {
+            level_queued_count[level].fetch_sub(1);
+            queued_count.fetch_sub(1);
+        }
+    }
+    return task;
+}
+
+uint64_t WorkerPool::get_queue_depth() const noexcept
+{
+    return queued_count.load(std::memory_order_relaxed);
+}
+
+uint64_t WorkerPool::get_queue_depth(const Priority priority) const noexcept
+{
+    return level_queued_count[static_cast<size_t> (priority)].load(std::memory_order_relaxed);
+}
+
+uint64_t WorkerPool::get_aged_count() const noexcept
+{
+    return aged_count.load(std::memory_order_relaxed);
+}
+
+uint64_t WorkerPool::get_steal_count() const noexcept
+{
+    return steal_count.load(std::memory_order_relaxed);
+}
+
+uint64_t WorkerPool::get_park_time() const noexcept
+{
+    return park_time.load(std::memory_order_relaxed) / 1000000;
+}
+
+uint64_t WorkerPool::get_thread_count() const noexcept
+{
+    return live_count.load(std::memory_order_relaxed);
+}
+
+uint64_t WorkerPool::get_spawn_count() const noexcept
+{
+    return spawn_count.load(std::memory_order_relaxed);
+}
+
+uint64_t WorkerPool::get_retire_count() const noexcept
+{
+    return retire_count.load(std::memory_order_relaxed);
+}
+
+void WorkerPool::worker_loop(Worker* const worker) noexcept
+{
+    current_worker = worker;
+    bool retired = false;
+    while (!stop_workers.load() && !retired)
+    {
+        Task* const task = find_task(worker);
+        if (task != nullptr)
+        {
+            pool_executor->run(task);
+        }
+        else
+        {
+            retired = park(worker);
+        }
+    }
+    current_worker = nullptr;
+    if (retired)
+    {
+        retire_count.fetch_add(1, std::memory_order_relaxed);
+    }
+    // The worker may be reused by another worker thread after this point
+    worker->live.store(false);
+}
+
+WorkerPool::Task* WorkerPool::find_task(Worker* const worker) noexcept
+{
+    Task* task = nullptr;
+    size_t task_level = 0;
+
+    // The lowest priority level that has reached the aging limit is served first
+    for (size_t level = PRIORITY_COUNT - 1; task == nullptr && level > 0; --level)
+    {
+        if (bypass_count[level].load(std::memory_order_relaxed) >= AGING_LIMIT)
+        {
+            task = find_level_task(worker, level);
+            if (task != nullptr)
+            {
+                task_level = level;
+                aged_count.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Priority levels without queued tasks are skipped, so that worker threads do not search all queues
+    // of all priority levels for each task
+    for (size_t level = 0; task == nullptr && level < PRIORITY_COUNT; ++level)
+    {
+        if (level_queued_count[level].load() > 0)
+        {
+            task = find_level_task(worker, level);
+            task_level = level;
+        }
+    }
+
+    if (task != nullptr)
+    {
+        level_queued_count[task_level].fetch_sub(1);
+        queued_count.fetch_sub(1);
+
+        bypass_count[task_level].store(0, std::memory_order_relaxed);
+        for (size_t level = task_level + 1; level < PRIORITY_COUNT; ++level)
+        {
+            if (level_queued_count[level].load(std::memory_order_relaxed) > 0)
+            {
+                bypass_count[level].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+    return task;
+}
+
+WorkerPool::Task* WorkerPool::find_level_task(Worker* const worker, const size_t level) noexcept
 {
-    pool_condition.notify_one();
+    Task* task = worker->local_queue_list[level]->dequeue();
+    if (task == nullptr)
+    {
+        task = shared_queue_list[level]->dequeue();
+    }
+    for (size_t offset = 1; task == nullptr && offset < pool_size; ++offset)
+    {
+        task = worker_list[(worker->index + offset) % pool_size].local_queue_list[level]->dequeue();
+        if (task != nullptr)
+        {
+            steal_count.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    return task;
 }
 
-void WorkerPool::worker_loop() noexcept
+bool WorkerPool::park(Worker* const worker) noexcept
 {
-    std::unique_lock<std::mutex> lock(*pool_lock);
-    while (!stop_workers)
+    // Register as idle before checking for tasks again: Either this check sees a task that was submitted
+    // concurrently, or the submitting thread sees the idle worker thread and unparks it
+    worker->parked.store(true);
+    idle_count.fetch_add(1);
+    if (queued_count.load() > 0 || stop_workers.load())
     {
-        // The pool_lock must be released while work is being done
-        // and must be reacquired afterwards before returning into
-        // this loop
-        pool_executor->run();
+        if (worker->parked.exchange(false))
+        {
+            idle_count.fetch_sub(1);
+            return false;
+        }
+        // else: Another thread has claimed this worker thread for unparking, wait for its permit
+    }
 
-        if (!stop_workers)
+    bool retired = false;
+    // Cleared if the worker thread is no longer registered as idle without having been unparked
+    bool idle = true;
+    // Set if another thread has claimed this worker thread for unparking, but has not set the permit yet
+    bool claimed = false;
+    std::unique_lock<std::mutex> lock(worker->park_lock);
+    const std::chrono::steady_clock::time_point park_start = std::chrono::steady_clock::now();
+    const std::chrono::steady_clock::time_point retire_time = park_start + idle_timeout;
+    while (idle && !worker->unpark_permit && !stop_workers.load())
+    {
+        if (claimed || live_count.load() <= min_workers)
         {
-            pool_condition.wait(lock);
+            worker->park_condition.wait(lock);
         }
+        else
+        if (worker->park_condition.wait_until(lock, retire_time) == std::cv_status::timeout)
+        {
+            if (reserve_retirement())
+            {
+                if (worker->parked.exchange(false))
+                {
+                    idle_count.fetch_sub(1);
+                    idle = false;
+                    // Same as above, either this check sees a task that was submitted concurrently, or the
+                    // submitting thread does not see this worker thread as idle and starts another one
+                    retired = queued_count.load() == 0;
+                    if (!retired)
+                    {
+                        live_count.fetch_add(1);
+                    }
+                }
+                else
+                {
+                    live_count.fetch_add(1);
+                    claimed = true;
+                }
+            }
+        }
+    }
+    worker->unpark_permit = false;
+    const std::chrono::steady_clock::duration park_duration = std::chrono::steady_clock::now() - park_start;
+    park_time.fetch_add(
+        static_cast<uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds>(park_duration).count()),
+        std::memory_order_relaxed
+    );
+
+    // If the worker thread was woken up by stop_threads(), it may still be registered as idle
+    if (worker->parked.exchange(false))
+    {
+        idle_count.fetch_sub(1);
     }
+    return retired;
+}
+
+bool WorkerPool::unpark_worker() noexcept
+{
+    bool unparked = false;
+    if (idle_count.load() > 0)
+    {
+        // Start searching at a different worker for each call, so that unparking is spread
+        // across the parked worker threads
+        const size_t start_index = next_worker.fetch_add(1, std::memory_order_relaxed);
+        for (size_t offset = 0; offset < pool_size && !unparked; ++offset)
+        {
+            Worker& worker = worker_list[(start_index + offset) % pool_size];
+            if (worker.parked.load(std::memory_order_relaxed) && worker.parked.exchange(false))
+            {
+                idle_count.fetch_sub(1);
+
+                {
+                    std::unique_lock<std::mutex> lock(worker.park_lock);
+                    worker.unpark_permit = true;
+                }
+                // Notified after unlocking the park_lock, so that the worker thread does not wake up
+                // only to block on the park_lock again
+                worker.park_condition.notify_one();
+                unparked = true;
+            }
+        }
+    }
+    return unparked;
+}
+
+// Caller must have locked the spawn_lock
+// @throws std::system_error
+void WorkerPool::start_worker()
+{
+    for (size_t idx = 0; idx < pool_size; ++idx)
+    {
+        Worker& worker = worker_list[idx];
+        if (!worker.live.load())
+        {
+            // Collect the worker thread that previously ran on this worker, which has already terminated
+            // or is about to terminate
+            if (worker.worker_thread.joinable())
+            {
+                worker.worker_thread.join();
+            }
+            worker.live.store(true);
+            live_count.fetch_add(1);
+            try
+            {
+                worker.worker_thread = std::thread(&WorkerPool::worker_loop, this, &worker);
+            }
+            catch (std::system_error&)
+            {
+                live_count.fetch_sub(1);
+                worker.live.store(false);
+                throw;
+            }
+            spawn_count.fetch_add(1, std::memory_order_relaxed);
+            break;
+        }
+    }
+}
+
+void WorkerPool::add_worker() noexcept
+{
+    if (live_count.load() < pool_size)
+    {
+        std::unique_lock<std::mutex> lock(spawn_lock, std::try_to_lock);
+        if (lock.owns_lock() && !stop_workers.load() && live_count.load() < pool_size)
+        {
+            try
+            {
+                start_worker();
+            }
+            catch (std::system_error&)
+            {
+                // The task is executed by one of the running worker threads
+            }
+        }
+    }
+}
+
+bool WorkerPool::reserve_retirement() noexcept
+{
+    bool reserved = false;
+    size_t count = live_count.load();
+    while (count > min_workers && !reserved)
+    {
+        reserved = live_count.compare_exchange_weak(count, count - 1);
+    }
+    return reserved;
 }
 
 void WorkerPool::stop_threads() noexcept
 {
     std::cout << ufh::LOGPFX_STOP << "Stopping worker threads" << std::endl;
     {
-        std::unique_lock<std::mutex> lock(*pool_lock);
-        stop_workers = true;
-        pool_condition.notify_all();
+        std::unique_lock<std::mutex> lock(spawn_lock);
+        stop_workers.store(true);
+    }
+    for (size_t idx = 0; idx < pool_size; ++idx)
+    {
+        // Locking the park_lock ensures that a worker thread that is about to park either sees
+        // the stop_workers flag or is waiting on the park_condition when it is notified
+        Worker& worker = worker_list[idx];
+        std::unique_lock<std::mutex> lock(worker.park_lock);
+        worker.park_condition.notify_all();
     }
     await_threads_termination();
 }
@@ -102,11 +503,12 @@ void WorkerPool::await_threads_termination() noexcept
 {
     for (size_t idx = 0; idx < pool_size; ++idx)
     {
-        if (pool_threads[idx].joinable())
+        std::thread& worker_thread = worker_list[idx].worker_thread;
+        if (worker_thread.joinable())
         {
             try
             {
-                pool_threads[idx].join();
+                worker_thread.join();
             }
             catch (std::system_error& ignored)
             {
@@ -2,43 +2,226 @@
 #define WORKERPOOL_H
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <atomic>
+#include <chrono>
 
+#include "MpmcQueue.h"
+
+// Work-stealing pool of worker threads
+//
+// Each worker thread has a queue of its own. Tasks submitted by a worker thread are queued on that
+// worker thread's queue, tasks submitted by other threads are queued on the shared queue, which is sized
+// for the maximum number of tasks. If a worker thread's queue is full, the task is queued on the shared
+// queue as well. A worker thread takes tasks from its own queue first, then from the shared queue, and
+// finally steals tasks from the queues of the other worker threads.
+//
+// Tasks are submitted with a priority level, and each priority level has its own set of queues.
+// Worker threads take tasks of higher priority levels first. To prevent starvation, a priority level
+// whose queued tasks have been bypassed in favor of tasks of higher priority levels AGING_LIMIT times
+// is served before all other priority levels for the next task.
+// The queues of all priority levels share the capacity for the maximum number of tasks, so that the
+// queues do not take up more memory than the queues of a pool without priority levels. If the shared queue
+// of a task's priority level is full, the task is queued on the shared queue of a lower priority level,
+// or of a higher priority level if there is no space on lower priority levels.
+//
+// A worker thread that does not find any task parks on a condition variable of its own. Submitting
+// a task unparks a single parked worker thread, so that worker threads do not contend on a common lock.
+//
+// The pool starts with the minimum number of worker threads. If a task is submitted while no worker
+// thread is parked, because all worker threads are busy, e.g. blocked in plugin calls, another worker
+// thread is started, up to the maximum number of worker threads. Worker threads in excess of the minimum
+// number of worker threads that have been parked for longer than the idle timeout terminate.
 class WorkerPool
 {
   public:
+    // Unit of work that is executed by a worker thread
+    // Objects that can be submitted to the pool must derive from WorkerPool::Task
+    class Task
+    {
+      public:
+        Task();
+        virtual ~Task() noexcept;
+        Task(const Task& other) = default;
+        Task(Task&& orig) = default;
+        virtual Task& operator=(const Task& other) = default;
+        virtual Task& operator=(Task&& orig) = default;
+    };
+
     class WorkerPoolExecutor
     {
       public:
         virtual ~WorkerPoolExecutor() noexcept;
-        virtual void run() noexcept = 0;
+        // Executes a task on a worker thread
+        virtual void run(Task* task) noexcept = 0;
+    };
+
+    enum class Priority : size_t
+    {
+        HIGH    = 0,
+        NORMAL  = 1,
+        LOW     = 2
     };
 
-    WorkerPool(std::mutex* lock, size_t worker_count, WorkerPoolExecutor* executor);
+    static const size_t PRIORITY_COUNT = 3;
+
+    static const size_t LOCAL_QUEUE_SIZE;
+    static const uint64_t AGING_LIMIT;
+
+    // max_task_count is the maximum number of tasks that can be submitted but not yet taken by a worker
+    // thread at any time, across all priority levels
+    // @throws std::bad_alloc
+    WorkerPool(
+        size_t min_worker_count,
+        size_t max_worker_count,
+        std::chrono::milliseconds worker_idle_timeout,
+        size_t max_task_count,
+        WorkerPoolExecutor* executor
+    );
     virtual ~WorkerPool() noexcept;
     WorkerPool(const WorkerPool& other) = delete;
-    WorkerPool(WorkerPool&& orig);
+    WorkerPool(WorkerPool&& orig) = delete;
     virtual WorkerPool& operator=(const WorkerPool& other) = delete;
     virtual WorkerPool& operator=(WorkerPool&& orig) = delete;
 
+    // Starts the minimum number of worker threads
+    // @throws std::system_error
     virtual void start();
     virtual void stop() noexcept;
-    virtual void notify() noexcept;
+
+    // Queues a task for execution, may be called by any thread
+    // Returns false if the task could not be queued, which is impossible unless more than
+    // max_task_count tasks are submitted
+    virtual bool submit(Task* task, Priority priority) noexcept;
+
+    // Removes a queued task without executing it, e.g. for releasing tasks on shutdown
+    // Returns nullptr if no tasks are queued
+    virtual Task* take() noexcept;
+
+    // Number of tasks that have been submitted but not taken yet
+    virtual uint64_t get_queue_depth() const noexcept;
+    // Number of tasks of the specified priority level that have been submitted but not taken yet
+    // Tasks that were queued on a queue of another priority level, because the queues of their own priority
+    // level were full, are counted at the priority level of that queue
+    virtual uint64_t get_queue_depth(Priority priority) const noexcept;
+    // Number of tasks that were taken ahead of tasks of higher priority levels due to aging
+    virtual uint64_t get_aged_count() const noexcept;
+    // Number of tasks that worker threads have stolen from other worker threads' queues
+    virtual uint64_t get_steal_count() const noexcept;
+    // Total time that worker threads spent parked, in milliseconds
+    virtual uint64_t get_park_time() const noexcept;
+    // Number of running worker threads
+    virtual uint64_t get_thread_count() const noexcept;
+    // Number of worker threads that have been started, including the minimum number of worker threads
+    virtual uint64_t get_spawn_count() const noexcept;
+    // Number of worker threads that have terminated after exceeding the idle timeout
+    virtual uint64_t get_retire_count() const noexcept;
 
   private:
-    std::mutex*                     pool_lock;
-    std::condition_variable         pool_condition;
-    std::unique_ptr<std::thread[]>  pool_threads_mgr;
-    std::thread*                    pool_threads        = nullptr;
+    class Worker
+    {
+      public:
+        WorkerPool*             pool            = nullptr;
+        size_t                  index           = 0;
+        std::thread             worker_thread;
+        // One queue for each priority level
+        std::unique_ptr<MpmcQueue<Task>>    local_queue_list[PRIORITY_COUNT];
+
+        std::mutex              park_lock;
+        std::condition_variable park_condition;
+        // Set by the thread that unparks the worker thread, protected by the park_lock
+        bool                    unpark_permit   = false;
+        // Set while the worker thread is parked or about to park, cleared by the thread that claims
+        // the worker thread for unparking
+        std::atomic<bool>       parked;
+        // Set while a worker thread is running on this worker, cleared by the worker thread when it terminates
+        std::atomic<bool>       live;
+
+        // @throws std::bad_alloc
+        Worker();
+        virtual ~Worker() noexcept;
+        Worker(const Worker& other) = delete;
+        Worker(Worker&& orig) = delete;
+        virtual Worker& operator=(const Worker& other) = delete;
+        virtual Worker& operator=(Worker&& orig) = delete;
+    };
+
+    // The worker that the current thread belongs to, nullptr for threads that are not worker threads
+    static thread_local Worker*     current_worker;
+
+    // One worker for each of the maximum number of worker threads
+    std::unique_ptr<Worker[]>       worker_list_mgr;
+    Worker*                         worker_list         = nullptr;
     size_t                          pool_size           = 0;
+    size_t                          min_workers         = 0;
+    std::chrono::milliseconds       idle_timeout;
     WorkerPoolExecutor*             pool_executor       = nullptr;
-    volatile bool                   stop_workers        = false;
+    // One shared queue for each priority level
+    std::unique_ptr<MpmcQueue<Task>>    shared_queue_list[PRIORITY_COUNT];
+
+    // Serializes starting worker threads and stopping the pool
+    std::mutex                      spawn_lock;
+    std::atomic<bool>               stop_workers;
+    // Number of running worker threads
+    std::atomic<size_t>             live_count;
+    // Number of worker threads that are parked or about to park
+    std::atomic<size_t>             idle_count;
+    // Worker that the next search for a parked worker thread starts at
+    std::atomic<size_t>             next_worker;
+
+    // Number of tasks that have been submitted but not taken yet, across all priority levels and for
+    // each priority level
+    std::atomic<uint64_t>           queued_count;
+    std::atomic<uint64_t>           level_queued_count[PRIORITY_COUNT];
+    // Number of tasks of higher priority levels that were taken while tasks of each priority level were queued,
+    // reset whenever a task of the priority level is taken
+    std::atomic<uint64_t>           bypass_count[PRIORITY_COUNT];
+    std::atomic<uint64_t>           aged_count;
+    std::atomic<uint64_t>           steal_count;
+    // Nanoseconds
+    std::atomic<uint64_t>           park_time;
+    std::atomic<uint64_t>           spawn_count;
+    std::atomic<uint64_t>           retire_count;
 
     void stop_threads() noexcept;
     void await_threads_termination() noexcept;
-    void worker_loop() noexcept;
+    void worker_loop(Worker* worker) noexcept;
+
+    // Returns the next task for the worker thread, or nullptr if no task was found
+    Task* find_task(Worker* worker) noexcept;
+
+    // Returns the next task of the specified priority level for the worker thread, or nullptr if no task
+    // of that priority level was found
+    Task* find_level_task(Worker* worker, size_t level) noexcept;
+
+    // Parks the worker thread until it is unparked or the pool is stopped, unless tasks have been
+    // submitted after the worker thread failed to find a task
+    // Returns true if the worker thread must terminate, because it exceeded the idle timeout
+    bool park(Worker* worker) noexcept;
+
+    // Unparks a single parked worker thread
+    // Returns false if there was no parked worker thread
+    bool unpark_worker() noexcept;
+
+    // Starts a worker thread on an unused worker, unless the maximum number of worker threads is running
+    // Caller must have locked the spawn_lock
+    // @throws std::system_error
+    void start_worker();
+
+    // Starts another worker thread, unless the maximum number of worker threads is running or another
+    // thread is currently starting a worker thread
+    void add_worker() noexcept;
+
+    // Decrements the live_count, unless the minimum number of worker threads would not be running anymore
+    bool reserve_retirement() noexcept;
+
+    // Queues a task on a queue of the specified priority level
+    // Returns false if the queue is full
+    bool enqueue_task(MpmcQueue<Task>& queue, size_t level, Task* task) noexcept;
 };
 
 #endif /* WORKERPOOL_H */
@@ -9,7 +9,7 @@ WorkerThreadInvocation::~WorkerThreadInvocation() noexcept
 {
 }
 
-void WorkerThreadInvocation::run() noexcept
+void WorkerThreadInvocation::run(WorkerPool::Task* const task) noexcept
 {
-    invocation_target->process_action_queue();
+    invocation_target->execute_task(task);
 }
@@ -18,7 +18,7 @@ class WorkerThreadInvocation : public WorkerPool::WorkerPoolExecutor
     virtual WorkerThreadInvocation& operator=(const WorkerThreadInvocation& other) = default;
     virtual WorkerThreadInvocation& operator=(WorkerThreadInvocation&& orig) = default;
 
-    virtual void run() noexcept;
+    virtual void run(WorkerPool::Task* task) noexcept;
 };
 
 #endif /* WORKERTHREADINVOCATION_H */
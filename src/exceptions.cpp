@@ -87,6 +87,7 @@ const char* const OsException::DSC_NBLK_IO_ERROR        = "Non-blocking I/O init
 const char* const OsException::DSC_IPC_ERROR            = "IPC setup failed";
 const char* const OsException::DSC_DYN_LOAD_ERROR       = "Dynamic loader/linker failed";
 const char* const OsException::DSC_SIGNAL_HND_ERROR     = "Signal handler setup failed";
+const char* const OsException::DSC_SELECTOR_ERROR       = "Selector backend operation failed";
 
 OsException::OsException() noexcept
 {
@@ -129,6 +130,9 @@ const char* OsException::get_error_description() const noexcept
         case ErrorId::SIGNAL_HND_ERROR:
             description = DSC_SIGNAL_HND_ERROR;
             break;
+        case ErrorId::SELECTOR_ERROR:
+            description = DSC_SELECTOR_ERROR;
+            break;
         case ErrorId::UNKNOWN:
             // fall-through
         default:
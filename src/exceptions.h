@@ -78,7 +78,9 @@ class OsException : public std::exception
         // Dynamic load of a library failed
         DYN_LOAD_ERROR      = 5,
         // Signal handling error
-        SIGNAL_HND_ERROR    = 6
+        SIGNAL_HND_ERROR    = 6,
+        // Selector backend operation failed
+        SELECTOR_ERROR      = 7
     };
 
     static const char* const DSC_UNKNOWN;
@@ -88,6 +90,7 @@ class OsException : public std::exception
     static const char* const DSC_IPC_ERROR;
     static const char* const DSC_DYN_LOAD_ERROR;
     static const char* const DSC_SIGNAL_HND_ERROR;
+    static const char* const DSC_SELECTOR_ERROR;
 
   private:
     ErrorId exc_error = ErrorId::UNKNOWN;
@@ -49,6 +49,27 @@ void parse_ipv6(const CharBuffer& ip_string, const CharBuffer& port_string, stru
     address.sin6_scope_id = 0;
 }
 
+// Initializes the address of a unix domain socket from the path of the socket
+// @throws InetException
+void parse_unix(const CharBuffer& path_string, struct sockaddr_un& address)
+{
+    // The path must fit into sun_path including the terminating null character
+    const size_t path_length = path_string.length();
+    if (path_length == 0 || path_length >= sizeof (address.sun_path))
+    {
+        throw InetException(InetException::ErrorId::INVALID_ADDRESS);
+    }
+
+    address.sun_family = AF_UNIX;
+    const char* const path = path_string.c_str();
+    for (size_t idx = 0; idx < path_length; ++idx)
+    {
+        address.sun_path[idx] = path[idx];
+    }
+    address.sun_path[path_length] = '\0';
+}
+
+// For unix domain sockets, ip_string is the path of the socket and port_string is ignored
 // @throws std::bad_alloc, InetException
 void init_socket_address(
     const CharBuffer& protocol_string,
@@ -72,6 +93,12 @@ void init_socket_address(
         address_length = sizeof (struct sockaddr_in);
     }
     else
+    if (protocol_string == keyword::PROTO_UNIX)
+    {
+        socket_domain = AF_UNIX;
+        address_length = sizeof (struct sockaddr_un);
+    }
+    else
     {
         throw InetException(InetException::ErrorId::UNKNOWN_AF);
     }
@@ -89,6 +116,12 @@ void init_socket_address(
         struct sockaddr_in* inet_address = reinterpret_cast<struct sockaddr_in*> (address);
         parse_ipv4(ip_string, port_string, *inet_address);
     }
+    else
+    if (socket_domain == AF_UNIX)
+    {
+        struct sockaddr_un* unix_address = reinterpret_cast<struct sockaddr_un*> (address);
+        parse_unix(ip_string, *unix_address);
+    }
 }
 
 // @throws InetException
@@ -9,6 +9,7 @@ extern "C"
     #include <arpa/inet.h>
     #include <sys/types.h>
     #include <sys/socket.h>
+    #include <sys/un.h>
 }
 
 // @throws InetException
@@ -17,6 +18,11 @@ void parse_ipv4(const CharBuffer& ip_string, const CharBuffer& port_string, stru
 // @throws InetException
 void parse_ipv6(const CharBuffer& ip_string, const CharBuffer& port_string, struct sockaddr_in6& address);
 
+// Initializes the address of a unix domain socket from the path of the socket
+// @throws InetException
+void parse_unix(const CharBuffer& path_string, struct sockaddr_un& address);
+
+// For unix domain sockets, ip_string is the path of the socket and port_string is ignored
 // @throws std::bad_alloc, InetException
 void init_socket_address(
     const CharBuffer& protocol_string,
@@ -19,4 +19,36 @@ bool ufh_fence_on(void *context, const char *nodename, size_t nodename_length);
 
 bool ufh_fence_reboot(void *context, const char *nodename, size_t nodename_length);
 
+// Optional batch entry points
+//
+// If a plugin provides a batch entry point, fencing actions affecting multiple nodes are executed
+// by a single call of the batch entry point. Otherwise, the server calls the single node entry point
+// for each node. nodename_list contains node_count null-terminated node names, the length of each
+// node name is stored in the corresponding element of nodename_length_list. The result of the
+// fencing action for each node must be stored in the corresponding element of result_list.
+
+void ufh_fence_off_batch(
+    void *context,
+    const char *const *nodename_list,
+    const size_t *nodename_length_list,
+    size_t node_count,
+    bool *result_list
+);
+
+void ufh_fence_on_batch(
+    void *context,
+    const char *const *nodename_list,
+    const size_t *nodename_length_list,
+    size_t node_count,
+    bool *result_list
+);
+
+void ufh_fence_reboot_batch(
+    void *context,
+    const char *const *nodename_list,
+    const size_t *nodename_length_list,
+    size_t node_count,
+    bool *result_list
+);
+
 #endif /* PLUGIN_API_H */
@@ -15,6 +15,10 @@ namespace plugin
     const char* const SYMBOL_FENCE_ON       = "ufh_fence_on";
     const char* const SYMBOL_FENCE_REBOOT   = "ufh_fence_reboot";
 
+    const char* const SYMBOL_FENCE_OFF_BATCH    = "ufh_fence_off_batch";
+    const char* const SYMBOL_FENCE_ON_BATCH     = "ufh_fence_on_batch";
+    const char* const SYMBOL_FENCE_REBOOT_BATCH = "ufh_fence_reboot_batch";
+
     // @throws OsException
     void* load_plugin(const char* const path, function_table& functions)
     {
@@ -32,6 +36,17 @@ namespace plugin
         tmp_functions.ufh_fence_on = reinterpret_cast<fence_call> (dlsym(plugin_handle, SYMBOL_FENCE_ON));
         tmp_functions.ufh_fence_reboot = reinterpret_cast<fence_call> (dlsym(plugin_handle, SYMBOL_FENCE_REBOOT));
 
+        // Batch entry points are optional
+        tmp_functions.ufh_fence_off_batch = reinterpret_cast<fence_batch_call> (
+            dlsym(plugin_handle, SYMBOL_FENCE_OFF_BATCH)
+        );
+        tmp_functions.ufh_fence_on_batch = reinterpret_cast<fence_batch_call> (
+            dlsym(plugin_handle, SYMBOL_FENCE_ON_BATCH)
+        );
+        tmp_functions.ufh_fence_reboot_batch = reinterpret_cast<fence_batch_call> (
+            dlsym(plugin_handle, SYMBOL_FENCE_REBOOT_BATCH)
+        );
+
         if (tmp_functions.ufh_plugin_init != nullptr && tmp_functions.ufh_plugin_destroy != nullptr &&
             tmp_functions.ufh_fence_off != nullptr && tmp_functions.ufh_fence_on != nullptr &&
             tmp_functions.ufh_fence_reboot != nullptr)
@@ -55,5 +70,8 @@ namespace plugin
         functions.ufh_fence_off = nullptr;
         functions.ufh_fence_on = nullptr;
         functions.ufh_fence_reboot = nullptr;
+        functions.ufh_fence_off_batch = nullptr;
+        functions.ufh_fence_on_batch = nullptr;
+        functions.ufh_fence_reboot_batch = nullptr;
     }
 }
@@ -14,11 +14,21 @@ namespace plugin
     typedef init_rc (*init_call)();
     typedef void (*destroy_call)(void* context);
     typedef bool (*fence_call)(void* context, const char* nodename, size_t nodename_length);
+    typedef void (*fence_batch_call)(
+        void* context,
+        const char* const* nodename_list,
+        const size_t* nodename_length_list,
+        size_t node_count,
+        bool* result_list
+    );
 
     extern const char* const SYMBOL_INIT;
     extern const char* const SYMBOL_FENCE_OFF;
     extern const char* const SYMBOL_FENCE_ON;
     extern const char* const SYMBOL_FENCE_REBOOT;
+    extern const char* const SYMBOL_FENCE_OFF_BATCH;
+    extern const char* const SYMBOL_FENCE_ON_BATCH;
+    extern const char* const SYMBOL_FENCE_REBOOT_BATCH;
 
     struct function_table
     {
@@ -27,6 +37,11 @@ namespace plugin
         fence_call      ufh_fence_off       = nullptr;
         fence_call      ufh_fence_on        = nullptr;
         fence_call      ufh_fence_reboot    = nullptr;
+
+        // Optional, nullptr if the plugin does not provide a batch entry point
+        fence_batch_call    ufh_fence_off_batch     = nullptr;
+        fence_batch_call    ufh_fence_on_batch      = nullptr;
+        fence_batch_call    ufh_fence_reboot_batch  = nullptr;
     };
 
     // @throws OsException
@@ -5,11 +5,29 @@
 
 extern "C"
 {
+    #include <unistd.h>
+    #include <errno.h>
+    #include <sys/types.h>
     #include <sys/socket.h>
+    #include <sys/stat.h>
+    #include <sys/un.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
 }
 
 namespace socket_setup
 {
+    const size_t Tuning::OPTION_COUNT               = 8;
+    const uint32_t Tuning::MAX_DEFER_ACCEPT         = 3600;
+    const uint32_t Tuning::MAX_FASTOPEN_QUEUE       = 65535;
+    const uint32_t Tuning::MAX_BUFFER_SIZE          = 0x4000000;
+    // Kernel limits of TCP_KEEPIDLE, TCP_KEEPINTVL and TCP_KEEPCNT
+    const uint32_t Tuning::MAX_KEEPALIVE_IDLE       = 32767;
+    const uint32_t Tuning::MAX_KEEPALIVE_INTERVAL   = 32767;
+    const uint32_t Tuning::MAX_KEEPALIVE_COUNT      = 127;
+    // Milliseconds
+    const uint32_t Tuning::MAX_USER_TIMEOUT         = 86400000;
+
     void set_no_linger(const int socket_fd)
     {
         struct linger linger_setup;
@@ -27,4 +45,262 @@ namespace socket_setup
                 " failed" << std::endl;
         }
     }
+
+    bool set_reuse_port(const int socket_fd)
+    {
+        const int enable_flag = 1;
+        int rc = setsockopt(
+            socket_fd, SOL_SOCKET, SO_REUSEPORT, &enable_flag,
+            static_cast<socklen_t> (sizeof (enable_flag))
+        );
+        return rc == 0;
+    }
+
+    bool probe_bind(
+        const int                       socket_domain,
+        const struct sockaddr* const    address,
+        const socklen_t                 address_length,
+        const bool                      ipv6_only
+    )
+    {
+        bool probe_flag = false;
+        int probe_fd = socket(socket_domain, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (probe_fd >= 0)
+        {
+            if (socket_domain != AF_INET6 || !ipv6_only || set_ipv6_only(probe_fd))
+            {
+                probe_flag = bind(probe_fd, address, address_length) == 0;
+            }
+            sys::close_fd(probe_fd);
+        }
+        return probe_flag;
+    }
+
+    bool set_ipv6_only(const int socket_fd)
+    {
+        const int enable_flag = 1;
+        int rc = setsockopt(
+            socket_fd, IPPROTO_IPV6, IPV6_V6ONLY, &enable_flag,
+            static_cast<socklen_t> (sizeof (enable_flag))
+        );
+        return rc == 0;
+    }
+
+    void remove_stale_socket(const struct sockaddr* const address, const socklen_t address_length)
+    {
+        const struct sockaddr_un* const unix_address = reinterpret_cast<const struct sockaddr_un*> (address);
+        struct stat path_stat;
+        if (lstat(unix_address->sun_path, &path_stat) == 0 && S_ISSOCK(path_stat.st_mode))
+        {
+            // Connecting to the socket fails with ECONNREFUSED if no server is accepting connections
+            // The probe does not block if the server's queue of pending connections is full, connecting
+            // fails with EAGAIN instead, and the socket is left in place like with any error other than
+            // ECONNREFUSED
+            int probe_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+            if (probe_fd >= 0)
+            {
+                if (connect(probe_fd, address, address_length) != 0 && errno == ECONNREFUSED)
+                {
+                    std::cout << ufh::LOGPFX_CONT << "Removing stale socket " << unix_address->sun_path <<
+                        std::endl;
+                    unlink(unix_address->sun_path);
+                }
+                sys::close_fd(probe_fd);
+            }
+        }
+    }
+
+    bool get_peer_uid(const int socket_fd, uid_t& peer_uid)
+    {
+        struct ucred credentials;
+        socklen_t credentials_length = static_cast<socklen_t> (sizeof (credentials));
+        int rc = getsockopt(socket_fd, SOL_SOCKET, SO_PEERCRED, &credentials, &credentials_length);
+        if (rc == 0)
+        {
+            peer_uid = credentials.uid;
+        }
+        return rc == 0;
+    }
+
+    // @throws std::bad_alloc
+    Tuning::Tuning()
+    {
+        applied_count_mgr = std::unique_ptr<std::atomic<uint64_t>[]>(new std::atomic<uint64_t>[OPTION_COUNT]);
+        failed_count_mgr = std::unique_ptr<std::atomic<uint64_t>[]>(new std::atomic<uint64_t>[OPTION_COUNT]);
+        applied_count = applied_count_mgr.get();
+        failed_count = failed_count_mgr.get();
+        for (size_t idx = 0; idx < OPTION_COUNT; ++idx)
+        {
+            applied_count[idx].store(0);
+            failed_count[idx].store(0);
+        }
+    }
+
+    Tuning::~Tuning() noexcept
+    {
+    }
+
+    void Tuning::tune_listener(const int socket_fd) noexcept
+    {
+        if (recv_buffer_size != 0)
+        {
+            count_result(
+                Option::RCVBUF,
+                set_int_option(socket_fd, SOL_SOCKET, SO_RCVBUF, static_cast<int> (recv_buffer_size))
+            );
+        }
+        if (send_buffer_size != 0)
+        {
+            count_result(
+                Option::SNDBUF,
+                set_int_option(socket_fd, SOL_SOCKET, SO_SNDBUF, static_cast<int> (send_buffer_size))
+            );
+        }
+        if (defer_accept != 0)
+        {
+            count_result(
+                Option::DEFER_ACCEPT,
+                set_int_option(socket_fd, IPPROTO_TCP, TCP_DEFER_ACCEPT, static_cast<int> (defer_accept))
+            );
+        }
+        if (fastopen != 0)
+        {
+            count_result(
+                Option::FASTOPEN,
+                set_int_option(socket_fd, IPPROTO_TCP, TCP_FASTOPEN, static_cast<int> (fastopen))
+            );
+        }
+    }
+
+    void Tuning::tune_connection(const int socket_fd, const bool client_flag) noexcept
+    {
+        if (nodelay)
+        {
+            count_result(Option::NODELAY, set_int_option(socket_fd, IPPROTO_TCP, TCP_NODELAY, 1));
+        }
+        if (quickack)
+        {
+            count_result(Option::QUICKACK, set_int_option(socket_fd, IPPROTO_TCP, TCP_QUICKACK, 1));
+        }
+        // Accepted sockets inherit the buffer sizes of the listener socket
+        if (client_flag)
+        {
+            if (recv_buffer_size != 0)
+            {
+                count_result(
+                    Option::RCVBUF,
+                    set_int_option(socket_fd, SOL_SOCKET, SO_RCVBUF, static_cast<int> (recv_buffer_size))
+                );
+            }
+            if (send_buffer_size != 0)
+            {
+                count_result(
+                    Option::SNDBUF,
+                    set_int_option(socket_fd, SOL_SOCKET, SO_SNDBUF, static_cast<int> (send_buffer_size))
+                );
+            }
+            if (fastopen != 0)
+            {
+#ifdef TCP_FASTOPEN_CONNECT
+                count_result(Option::FASTOPEN, set_int_option(socket_fd, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, 1));
+#else
+                count_result(Option::FASTOPEN, false);
+#endif
+            }
+        }
+        if (keepalive_idle != 0)
+        {
+            bool success_flag = set_int_option(socket_fd, SOL_SOCKET, SO_KEEPALIVE, 1) &&
+                set_int_option(socket_fd, IPPROTO_TCP, TCP_KEEPIDLE, static_cast<int> (keepalive_idle));
+            if (success_flag && keepalive_interval != 0)
+            {
+                success_flag = set_int_option(
+                    socket_fd, IPPROTO_TCP, TCP_KEEPINTVL, static_cast<int> (keepalive_interval)
+                );
+            }
+            if (success_flag && keepalive_count != 0)
+            {
+                success_flag = set_int_option(socket_fd, IPPROTO_TCP, TCP_KEEPCNT, static_cast<int> (keepalive_count));
+            }
+            count_result(Option::KEEPALIVE, success_flag);
+        }
+        if (user_timeout != 0)
+        {
+            count_result(
+                Option::USER_TIMEOUT,
+                set_int_option(socket_fd, IPPROTO_TCP, TCP_USER_TIMEOUT, static_cast<int> (user_timeout))
+            );
+        }
+    }
+
+    void Tuning::rearm_quickack(const int socket_fd) const noexcept
+    {
+        if (quickack)
+        {
+            set_int_option(socket_fd, IPPROTO_TCP, TCP_QUICKACK, 1);
+        }
+    }
+
+    uint64_t Tuning::get_applied_count(const Option option) const noexcept
+    {
+        return applied_count[static_cast<size_t> (option)].load();
+    }
+
+    uint64_t Tuning::get_failed_count(const Option option) const noexcept
+    {
+        return failed_count[static_cast<size_t> (option)].load();
+    }
+
+    const char* Tuning::get_option_name(const Option option) noexcept
+    {
+        const char* name = "UNKNOWN";
+        switch (option)
+        {
+            case Option::NODELAY:
+                name = "TCP_NODELAY";
+                break;
+            case Option::QUICKACK:
+                name = "TCP_QUICKACK";
+                break;
+            case Option::DEFER_ACCEPT:
+                name = "TCP_DEFER_ACCEPT";
+                break;
+            case Option::FASTOPEN:
+                name = "TCP_FASTOPEN";
+                break;
+            case Option::RCVBUF:
+                name = "SO_RCVBUF";
+                break;
+            case Option::SNDBUF:
+                name = "SO_SNDBUF";
+                break;
+            case Option::KEEPALIVE:
+                name = "SO_KEEPALIVE";
+                break;
+            case Option::USER_TIMEOUT:
+                name = "TCP_USER_TIMEOUT";
+                break;
+            default:
+                break;
+        }
+        return name;
+    }
+
+    bool Tuning::set_int_option(const int socket_fd, const int level, const int name, const int value) noexcept
+    {
+        int rc = setsockopt(socket_fd, level, name, &value, static_cast<socklen_t> (sizeof (value)));
+        return rc == 0;
+    }
+
+    void Tuning::count_result(const Option option, const bool success_flag) noexcept
+    {
+        if (success_flag)
+        {
+            applied_count[static_cast<size_t> (option)].fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            failed_count[static_cast<size_t> (option)].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
 }
@@ -1,9 +1,139 @@
 #ifndef SOCKET_SETUP_H
 #define SOCKET_SETUP_H
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <atomic>
+
+extern "C"
+{
+    #include <sys/types.h>
+    #include <sys/socket.h>
+}
+
 namespace socket_setup
 {
     void set_no_linger(const int socket_fd);
+
+    // Allows multiple sockets to bind to the same address and port, with the kernel distributing
+    // incoming connections across those sockets
+    // Returns true if the option was set successfully, false otherwise
+    bool set_reuse_port(const int socket_fd);
+
+    // Binds a socket to the address without SO_REUSEPORT and closes it again, which fails if any other
+    // socket is bound to the address, including sockets that were bound with SO_REUSEPORT
+    // If ipv6_only is set, an IPv6 socket is restricted to IPv6 connections, see set_ipv6_only
+    // Returns true if the address is not in use, false otherwise
+    bool probe_bind(int socket_domain, const struct sockaddr* address, socklen_t address_length, bool ipv6_only);
+
+    // Restricts an IPv6 socket to IPv6 connections, so that an IPv4 socket can be bound to the same port
+    // Returns true if the option was set successfully, false otherwise
+    bool set_ipv6_only(const int socket_fd);
+
+    // Removes a unix domain socket that was left behind by a server that is no longer running,
+    // so that the path can be bound again
+    // The path is left unchanged if it is not a socket or if a server is still accepting connections
+    void remove_stale_socket(const struct sockaddr* address, socklen_t address_length);
+
+    // Retrieves the user ID of the process on the other end of a connected unix domain socket
+    // Returns true if the peer credentials were retrieved successfully, false otherwise
+    bool get_peer_uid(const int socket_fd, uid_t& peer_uid);
+
+    // Configurable TCP socket options, applied to listener sockets, accepted sockets and client sockets
+    //
+    // Options that are disabled or that have a value of zero are left at the system's defaults.
+    // The number of sockets that each option was applied to successfully or unsuccessfully is counted;
+    // the counters may be shared by multiple threads.
+    class Tuning
+    {
+      public:
+        enum class Option : uint8_t
+        {
+            // TCP_NODELAY
+            NODELAY         = 0,
+            // TCP_QUICKACK
+            QUICKACK        = 1,
+            // TCP_DEFER_ACCEPT, listener sockets only
+            DEFER_ACCEPT    = 2,
+            // TCP_FASTOPEN on listener sockets, TCP_FASTOPEN_CONNECT on client sockets
+            FASTOPEN        = 3,
+            // SO_RCVBUF
+            RCVBUF          = 4,
+            // SO_SNDBUF
+            SNDBUF          = 5,
+            // SO_KEEPALIVE, TCP_KEEPIDLE, TCP_KEEPINTVL and TCP_KEEPCNT
+            KEEPALIVE       = 6,
+            // TCP_USER_TIMEOUT
+            USER_TIMEOUT    = 7
+        };
+
+        static const size_t OPTION_COUNT;
+
+        // Upper limits of the option values
+        static const uint32_t MAX_DEFER_ACCEPT;
+        static const uint32_t MAX_FASTOPEN_QUEUE;
+        static const uint32_t MAX_BUFFER_SIZE;
+        static const uint32_t MAX_KEEPALIVE_IDLE;
+        static const uint32_t MAX_KEEPALIVE_INTERVAL;
+        static const uint32_t MAX_KEEPALIVE_COUNT;
+        static const uint32_t MAX_USER_TIMEOUT;
+
+        bool        nodelay             = false;
+        bool        quickack            = false;
+        // Seconds to wait for the first data of a connection before the connection is accepted
+        uint32_t    defer_accept        = 0;
+        // Length of the queue of pending fast open connections on listener sockets,
+        // any nonzero value enables fast open on client sockets
+        uint32_t    fastopen            = 0;
+        // Bytes
+        uint32_t    recv_buffer_size    = 0;
+        uint32_t    send_buffer_size    = 0;
+        // Seconds; keepalive is enabled if keepalive_idle is nonzero
+        uint32_t    keepalive_idle      = 0;
+        uint32_t    keepalive_interval  = 0;
+        uint32_t    keepalive_count     = 0;
+        // Milliseconds
+        uint32_t    user_timeout        = 0;
+
+        // @throws std::bad_alloc
+        Tuning();
+        virtual ~Tuning() noexcept;
+        Tuning(const Tuning& other) = delete;
+        Tuning(Tuning&& orig) = delete;
+        virtual Tuning& operator=(const Tuning& other) = delete;
+        virtual Tuning& operator=(Tuning&& orig) = delete;
+
+        // Applies the options of a listener socket, must be called before listen()
+        // The socket buffer sizes are inherited by accepted sockets
+        virtual void tune_listener(int socket_fd) noexcept;
+
+        // Applies the options of an accepted socket, or of a client socket before connecting, which
+        // is selected by client_flag
+        virtual void tune_connection(int socket_fd, bool client_flag) noexcept;
+
+        // Reenables TCP_QUICKACK, if the option is enabled
+        // The kernel clears TCP_QUICKACK whenever it switches back to delayed acknowledgements,
+        // therefore the option must be reenabled after receiving data
+        virtual void rearm_quickack(int socket_fd) const noexcept;
+
+        virtual uint64_t get_applied_count(Option option) const noexcept;
+        virtual uint64_t get_failed_count(Option option) const noexcept;
+
+        // Returns the name of the option, e.g. for statistics output
+        static const char* get_option_name(Option option) noexcept;
+
+      private:
+        std::unique_ptr<std::atomic<uint64_t>[]>    applied_count_mgr;
+        std::unique_ptr<std::atomic<uint64_t>[]>    failed_count_mgr;
+        std::atomic<uint64_t>*  applied_count   = nullptr;
+        std::atomic<uint64_t>*  failed_count    = nullptr;
+
+        // Sets an integer socket option, returns true if successful
+        static bool set_int_option(int socket_fd, int level, int name, int value) noexcept;
+
+        void count_result(Option option, bool success_flag) noexcept;
+    };
 }
 
 #endif /* SOCKET_SETUP_H */